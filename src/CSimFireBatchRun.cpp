@@ -0,0 +1,616 @@
+//****************************************************************************************************
+//! \file CSimFireBatchRun.cpp
+//! Module contains definitions of CSimFireBatchRun class, declared in CSimFireBatchRun.h, which
+//! simulates a whole bunch of shots at once (in lockstep, using SIMD instructions).
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <CSimFireBatchRun.h>
+
+#if defined( _M_X64 ) || defined( __x86_64__ )
+  #define SIMFIRE_X86_64
+  #include <immintrin.h>
+  #if defined( _MSC_VER )
+    #include <intrin.h>
+    #define SIMFIRE_TARGET_AVX2
+  #else
+    #define SIMFIRE_TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+  #endif
+#endif
+                        // SSE2 is part of x64 baseline, AVX2 kernel is compiled for AVX2 regardless of
+                        // compiler options and is called only if the CPU supports it (runtime dispatch).
+
+namespace SimFire
+{
+
+  //****** CSimFireBatchRun **************************************************************************
+
+  CSimFireBatchRun::CSimFireBatchRun(
+    const CSimFireSettings & settings,
+    CSimFireSingleRun::LogCallback_t fnCall ):
+    mSettings( settings ),
+    mLogCallback( fnCall ),
+    mSimdLevel( settings.GetSimdLevel() ),
+    mCancelToken( nullptr ),
+    mRunParams( nullptr )
+  {
+    auto detected = DetectSimdLevel();
+    if( SimdLevel_t::kAuto == mSimdLevel || detected < mSimdLevel )
+      mSimdLevel = detected;
+                        // Instruction set required by the user is used only if the CPU supports it
+  } // CSimFireBatchRun::CSimFireBatchRun
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireBatchRun::~CSimFireBatchRun() = default;
+
+  //-------------------------------------------------------------------------------------------------
+
+  SimdLevel_t CSimFireBatchRun::DetectSimdLevel()
+  {
+#if defined( SIMFIRE_X86_64 )
+  #if defined( _MSC_VER )
+    int info[4];
+    __cpuid( info, 0 );
+    if( 7 <= info[0] )
+    {
+      __cpuidex( info, 1, 0 );
+      bool osxsave = ( 0 != ( info[2] & ( 1 << 27 ) ) );
+      bool avx = ( 0 != ( info[2] & ( 1 << 28 ) ) );
+      if( osxsave && avx && 6 == ( _xgetbv( 0 ) & 6 ) )
+      {                 // AVX registers are saved by operating system
+        __cpuidex( info, 7, 0 );
+        if( 0 != ( info[1] & ( 1 << 5 ) ) )
+          return SimdLevel_t::kAVX2;
+      } // if
+    } // if
+  #else
+    if( __builtin_cpu_supports( "avx2" ) )
+      return SimdLevel_t::kAVX2;
+  #endif
+    return SimdLevel_t::kSSE2;
+#else
+    return SimdLevel_t::kScalar;
+#endif
+  } // CSimFireBatchRun::DetectSimdLevel
+
+  //-------------------------------------------------------------------------------------------------
+
+  const std::string & CSimFireBatchRun::GetStrValue( SimdLevel_t level )
+  {
+    static const std::string lAuto( "auto" );
+    static const std::string lScalar( "scalar" );
+    static const std::string lSSE2( "sse2" );
+    static const std::string lAVX2( "avx2" );
+    static const std::string lInvalidCode( "InvalidCode" );
+
+    switch( level )
+    {
+      case SimdLevel_t::kAuto:    return lAuto;
+      case SimdLevel_t::kScalar:  return lScalar;
+      case SimdLevel_t::kSSE2:    return lSSE2;
+      case SimdLevel_t::kAVX2:    return lAVX2;
+      default:                    return lInvalidCode;
+    } // switch
+  } // CSimFireBatchRun::GetStrValue
+
+  //-------------------------------------------------------------------------------------------------
+
+  int CSimFireBatchRun::Run( std::span<CSimFireSingleRunParams> runParams )
+  {
+    int res = 0;
+
+    mRunParams = runParams.data();
+    size_t nrOfRuns = runParams.size();
+
+    mX.resize( nrOfRuns );
+    mY.resize( nrOfRuns );
+    mZ.resize( nrOfRuns );
+    mVX.resize( nrOfRuns );
+    mVY.resize( nrOfRuns );
+    mVZ.resize( nrOfRuns );
+    mMinDSq.resize( nrOfRuns );
+    mMinTime.resize( nrOfRuns );
+    mRaising.resize( nrOfRuns );
+    mBelow.resize( nrOfRuns );
+    mNear.resize( nrOfRuns );
+    mDone.resize( nrOfRuns );
+    mLaneRun.resize( nrOfRuns );
+
+    //------ Constant parameters -------------------------------------------------------------------
+
+    BatchConsts_t c;
+    c.dt = mSettings.GetDt();
+    c.dtg = mSettings.GetDt() * mSettings.GetG();
+
+    double_t crossSection = gPI * mSettings.GetBulletSize() * mSettings.GetBulletSize();
+    double_t tdCoef = mSettings.GetDt() * 0.5 * mSettings.GetDensity();
+    c.dragCoef = IsPositive( tdCoef ) ? tdCoef * mSettings.GetCd() * crossSection : 0.0;
+                        // Same association order as in procADRG, drag is not applied in vacuum
+    c.mass = mSettings.GetMass();
+
+    c.tgtX = mSettings.GetTgtX();
+    c.tgtY = mSettings.GetTgtY();
+    c.tgtZ = mSettings.GetTgtZ();
+    double_t radiusSum = mSettings.GetBulletSize() + mSettings.GetTgtSize();
+    c.radiusSumSq = radiusSum * radiusSum;
+
+    c.nX = mSettings.GetGunX() - c.tgtX;
+    c.nY = mSettings.GetGunY() - c.tgtY;
+    c.nZ = mSettings.GetGunZ() - c.tgtZ;
+    c.nD = -( c.nX * c.tgtX + c.nY * c.tgtY + c.nZ * c.tgtZ );
+    c.refNegative = ( c.nX * mSettings.GetGunX() + c.nY * mSettings.GetGunY() + c.nZ * mSettings.GetGunZ() + c.nD < 0.0 );
+                        // Half-space plane, see CSimFireSingleRun::Run
+    c.receding = mSettings.GetRecedingTermination();
+
+    //------ Lanes initialization ------------------------------------------------------------------
+
+    size_t nActive = 0;
+    for( size_t runIdx = 0; runIdx < nrOfRuns; ++runIdx )
+    {
+      auto & item = mRunParams[runIdx];
+
+      double_t div = std::sqrt(
+        item.mVelocityXCoef * item.mVelocityXCoef +
+        item.mVelocityYCoef * item.mVelocityYCoef +
+        item.mVelocityZCoef * item.mVelocityZCoef );
+      if( IsZero( div ) )
+      {
+        SIMFIRE_LOG( *this, LogLevel_t::kWarning, item.GetRunIdentifier(),
+          "Zero velocity direction coefficients given, cannot proceed." );
+        res = -1;
+        continue;
+      } // if
+
+      double velCoef = mSettings.GetVelocity() / div;
+
+      mX[nActive] = mSettings.GetGunX();
+      mY[nActive] = mSettings.GetGunY();
+      mZ[nActive] = mSettings.GetGunZ();
+      mVX[nActive] = item.mVelocityXCoef * velCoef;
+      mVY[nActive] = item.mVelocityYCoef * velCoef;
+      mVZ[nActive] = item.mVelocityZCoef * velCoef;
+      mMinDSq[nActive] = item.mMinDTgtSq;
+      mMinTime[nActive] = item.mMinTime;
+      mRaising[nActive] = item.mRaising ? 1.0 : 0.0;
+      mBelow[nActive] = item.mBelow ? 1.0 : 0.0;
+      mNear[nActive] = item.mNearHalfPlane ? 1.0 : 0.0;
+      mDone[nActive] = kLaneRunning;
+      mLaneRun[nActive] = runIdx;
+      ++nActive;
+    } // for
+
+    //------ Main simulation loop ------------------------------------------------------------------
+
+    uint64_t actualTick = 0;
+    uint64_t maxTicks = /**//**//**/1000000000/**//**//**/;
+    double_t actSimTime = 0.0;
+
+    while( 0 < nActive )
+    {
+      if( nullptr != mCancelToken && 0 == actualTick % gCancelCheckTicks &&
+          mCancelToken->load( std::memory_order_relaxed ) )
+      {                 // Solution was found elsewhere, all lanes still in flight are cancelled
+        while( 0 < nActive )
+        {
+          mDone[nActive - 1] = kLaneCancelled;
+          RetireLane( nActive - 1, nActive, actualTick, actSimTime );
+        } // while
+        break;
+      } // if
+
+      actSimTime += c.dt;
+
+      bool anyDone = false;
+      switch( mSimdLevel )
+      {
+        case SimdLevel_t::kAVX2:  anyDone = TickAVX2( c, nActive, actSimTime ); break;
+        case SimdLevel_t::kSSE2:  anyDone = TickSSE2( c, nActive, actSimTime ); break;
+        default:                  anyDone = TickScalar( c, 0, nActive, actSimTime ); break;
+      } // switch
+
+      if( c.receding )
+      {                 // Same test as in CSimFireSingleRun::Run, landing and hit have precedence
+        for( size_t lane = 0; lane < nActive; ++lane )
+        {
+          if( kLaneRunning != mDone[lane] )
+            continue;
+          double_t bRefVal = c.nX * mX[lane] + c.nY * mY[lane] + c.nZ * mZ[lane] + c.nD;
+          bool nearHalfPlane = ( c.refNegative ? ( bRefVal < 0.0 ) : ( bRefVal > 0.0 ) );
+          if( ! nearHalfPlane && ProvablyReceding( mX[lane] - c.tgtX, mY[lane] - c.tgtY, mVX[lane], mVY[lane],
+                std::max( mMinDSq[lane], c.radiusSumSq ) ) )
+          {
+            mDone[lane] = kLaneReceding;
+            anyDone = true;
+          } // if
+        } // for
+      } // if
+
+      if( anyDone )
+      {                 // Lanes are checked from the end, so the lane moved into place of retired one
+                        // has been already checked.
+        for( size_t lane = nActive; 0 < lane--; )
+        {
+          if( kLaneRunning != mDone[lane] )
+            RetireLane( lane, nActive, actualTick + 1, actSimTime );
+        } // for
+      } // if
+
+      ++actualTick;
+      if( actualTick >= maxTicks )
+        break;
+
+    } // while
+
+    while( 0 < nActive )
+    {                   // Maximal number of ticks reached
+      mDone[nActive - 1] = kLaneRunning;
+      RetireLane( nActive - 1, nActive, actualTick, actSimTime );
+    } // while
+
+    return res;
+
+  } // CSimFireBatchRun::Run
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireBatchRun::RetireLane( size_t lane, size_t & nActive, uint64_t ticks, double_t actSimTime )
+  {
+    auto & item = mRunParams[mLaneRun[lane]];
+
+    item.mMinDTgtSq = mMinDSq[lane];
+    item.mMinTime = mMinTime[lane];
+    item.mRaising = ( 0.0 != mRaising[lane] );
+    item.mBelow = ( 0.0 != mBelow[lane] );
+    item.mNearHalfPlane = ( 0.0 != mNear[lane] );
+    item.mSimTime = actSimTime;
+    item.mSteps = ticks;
+    item.mRejectedSteps = 0;
+    item.mMinStep = item.mMaxStep = mSettings.GetDt();
+
+    switch( mDone[lane] )
+    {
+      case kLaneLanded:
+        item.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kEndedNoActive;
+        SIMFIRE_LOG( *this, LogLevel_t::kTrace, item.GetRunIdentifier(),
+          "Simulation ended: no active objects left in the scene." );
+        break;
+      case kLaneHit:
+        item.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kEndedCollision;
+        {               // Contact point lies on the line of centres, in ratio of radii
+          double_t k = mSettings.GetBulletSize() / ( mSettings.GetBulletSize() + mSettings.GetTgtSize() );
+          item.mImpactTime = actSimTime;
+          item.mContactX = mX[lane] + k * ( mSettings.GetTgtX() - mX[lane] );
+          item.mContactY = mY[lane] + k * ( mSettings.GetTgtY() - mY[lane] );
+          item.mContactZ = mZ[lane] + k * ( mSettings.GetTgtZ() - mZ[lane] );
+        }
+        if( nullptr != mCancelToken && mSettings.GetStopOnFirstHit() )
+          mCancelToken->store( true, std::memory_order_relaxed );
+        SIMFIRE_LOG( *this, LogLevel_t::kTrace, item.GetRunIdentifier(), "Simulation ended: collision detected." );
+        break;
+      case kLaneReceding:
+        item.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kEndedReceding;
+        SIMFIRE_LOG( *this, LogLevel_t::kTrace, item.GetRunIdentifier(),
+          "Simulation ended: bullet is receding from the target." );
+        break;
+      case kLaneCancelled:
+        item.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kCancelled;
+        SIMFIRE_LOG( *this, LogLevel_t::kTrace, item.GetRunIdentifier(),
+          "Simulation cancelled: solution was already found." );
+        break;
+      default:
+        item.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kEndedMaxTicks;
+        SIMFIRE_LOG( *this, LogLevel_t::kTrace, item.GetRunIdentifier(),
+          "Simulation ended: maximum number of ticks reached." );
+        break;
+    } // switch
+
+    size_t last = --nActive;
+    if( lane != last )
+    {
+      mX[lane] = mX[last];
+      mY[lane] = mY[last];
+      mZ[lane] = mZ[last];
+      mVX[lane] = mVX[last];
+      mVY[lane] = mVY[last];
+      mVZ[lane] = mVZ[last];
+      mMinDSq[lane] = mMinDSq[last];
+      mMinTime[lane] = mMinTime[last];
+      mRaising[lane] = mRaising[last];
+      mBelow[lane] = mBelow[last];
+      mNear[lane] = mNear[last];
+      mDone[lane] = mDone[last];
+      mLaneRun[lane] = mLaneRun[last];
+    } // if
+
+  } // CSimFireBatchRun::RetireLane
+
+  //-------------------------------------------------------------------------------------------------
+
+  bool CSimFireBatchRun::TickScalar( const BatchConsts_t & c, size_t from, size_t to, double_t actSimTime )
+  {
+    bool anyDone = false;
+
+    for( size_t lane = from; lane < to; ++lane )
+    {
+      double_t x = mX[lane] + mVX[lane] * c.dt;
+      double_t y = mY[lane] + mVY[lane] * c.dt;
+      double_t z = mZ[lane] + mVZ[lane] * c.dt;
+                        // procURM
+
+      double_t vX = mVX[lane];
+      double_t vY = mVY[lane];
+      double_t vZ = mVZ[lane];
+
+      if( 0.0 != c.dragCoef )
+      {                 // procADRG
+        double_t actV = vX * vX + vY * vY + vZ * vZ;
+        double_t deltaV = c.dragCoef * actV / c.mass;
+        actV = std::sqrt( actV );
+
+        double_t commonCoef = ( actV - deltaV ) / actV;
+
+        vX *= commonCoef;
+        vY *= commonCoef;
+        vZ *= commonCoef;
+      } // if
+
+      vZ -= c.dtg;      // procDVA
+
+      mX[lane] = x; mY[lane] = y; mZ[lane] = z;
+      mVX[lane] = vX; mVY[lane] = vY; mVZ[lane] = vZ;
+
+      double_t distX = x - c.tgtX;
+      double_t distY = y - c.tgtY;
+      double_t distZ = z - c.tgtZ;
+      double_t distSq = distX * distX + distY * distY + distZ * distZ;
+
+      if( distSq < mMinDSq[lane] )
+      {                 // procCAT
+        mMinDSq[lane] = distSq;
+        mMinTime[lane] = actSimTime;
+        mRaising[lane] = ( vZ >= 0.0 ) ? 1.0 : 0.0;
+        mBelow[lane] = ( z < c.tgtZ ) ? 1.0 : 0.0;
+        double_t bRefVal = c.nX * x + c.nY * y + c.nZ * z + c.nD;
+        mNear[lane] = ( c.refNegative ? ( bRefVal < 0.0 ) : ( bRefVal > 0.0 ) ) ? 1.0 : 0.0;
+      } // if
+
+      if( z <= 0.0 )
+      {                 // procOCS, ground has precedence (see CSimFireSingleRun::Run)
+        mDone[lane] = kLaneLanded;
+        anyDone = true;
+      } // if
+      else if( distSq < c.radiusSumSq )
+      {                 // procOCC
+        mDone[lane] = kLaneHit;
+        anyDone = true;
+      } // else if
+
+    } // for
+
+    return anyDone;
+
+  } // CSimFireBatchRun::TickScalar
+
+  //-------------------------------------------------------------------------------------------------
+
+  bool CSimFireBatchRun::TickSSE2( const BatchConsts_t & c, size_t to, double_t actSimTime )
+  {
+#if defined( SIMFIRE_X86_64 )
+    const __m128d dt = _mm_set1_pd( c.dt );
+    const __m128d dtg = _mm_set1_pd( c.dtg );
+    const __m128d dragCoef = _mm_set1_pd( c.dragCoef );
+    const __m128d mass = _mm_set1_pd( c.mass );
+    const __m128d tgtX = _mm_set1_pd( c.tgtX );
+    const __m128d tgtY = _mm_set1_pd( c.tgtY );
+    const __m128d tgtZ = _mm_set1_pd( c.tgtZ );
+    const __m128d radiusSumSq = _mm_set1_pd( c.radiusSumSq );
+    const __m128d nX = _mm_set1_pd( c.nX );
+    const __m128d nY = _mm_set1_pd( c.nY );
+    const __m128d nZ = _mm_set1_pd( c.nZ );
+    const __m128d nD = _mm_set1_pd( c.nD );
+    const __m128d t = _mm_set1_pd( actSimTime );
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd( 1.0 );
+
+    auto blend = []( __m128d a, __m128d b, __m128d mask )
+      { return _mm_or_pd( _mm_and_pd( mask, b ), _mm_andnot_pd( mask, a ) ); };
+                        // SSE2 has no blend instruction (SSE4.1)
+
+    bool anyDone = false;
+    size_t lane = 0;
+
+    for( ; lane + 2 <= to; lane += 2 )
+    {
+      __m128d vX = _mm_loadu_pd( &mVX[lane] );
+      __m128d vY = _mm_loadu_pd( &mVY[lane] );
+      __m128d vZ = _mm_loadu_pd( &mVZ[lane] );
+
+      __m128d x = _mm_add_pd( _mm_loadu_pd( &mX[lane] ), _mm_mul_pd( vX, dt ) );
+      __m128d y = _mm_add_pd( _mm_loadu_pd( &mY[lane] ), _mm_mul_pd( vY, dt ) );
+      __m128d z = _mm_add_pd( _mm_loadu_pd( &mZ[lane] ), _mm_mul_pd( vZ, dt ) );
+
+      if( 0.0 != c.dragCoef )
+      {
+        __m128d actV = _mm_add_pd( _mm_add_pd( _mm_mul_pd( vX, vX ), _mm_mul_pd( vY, vY ) ), _mm_mul_pd( vZ, vZ ) );
+        __m128d deltaV = _mm_div_pd( _mm_mul_pd( dragCoef, actV ), mass );
+        actV = _mm_sqrt_pd( actV );
+        __m128d commonCoef = _mm_div_pd( _mm_sub_pd( actV, deltaV ), actV );
+        vX = _mm_mul_pd( vX, commonCoef );
+        vY = _mm_mul_pd( vY, commonCoef );
+        vZ = _mm_mul_pd( vZ, commonCoef );
+      } // if
+
+      vZ = _mm_sub_pd( vZ, dtg );
+
+      _mm_storeu_pd( &mX[lane], x );
+      _mm_storeu_pd( &mY[lane], y );
+      _mm_storeu_pd( &mZ[lane], z );
+      _mm_storeu_pd( &mVX[lane], vX );
+      _mm_storeu_pd( &mVY[lane], vY );
+      _mm_storeu_pd( &mVZ[lane], vZ );
+
+      __m128d distX = _mm_sub_pd( x, tgtX );
+      __m128d distY = _mm_sub_pd( y, tgtY );
+      __m128d distZ = _mm_sub_pd( z, tgtZ );
+      __m128d distSq = _mm_add_pd( _mm_add_pd( _mm_mul_pd( distX, distX ), _mm_mul_pd( distY, distY ) ),
+                                   _mm_mul_pd( distZ, distZ ) );
+
+      __m128d minDSq = _mm_loadu_pd( &mMinDSq[lane] );
+      __m128d better = _mm_cmplt_pd( distSq, minDSq );
+      if( 0 != _mm_movemask_pd( better ) )
+      {
+        __m128d bRefVal = _mm_add_pd( _mm_add_pd( _mm_add_pd( _mm_mul_pd( nX, x ), _mm_mul_pd( nY, y ) ),
+                                                  _mm_mul_pd( nZ, z ) ), nD );
+        __m128d nearMask = c.refNegative ? _mm_cmplt_pd( bRefVal, zero ) : _mm_cmpgt_pd( bRefVal, zero );
+
+        _mm_storeu_pd( &mMinDSq[lane], blend( minDSq, distSq, better ) );
+        _mm_storeu_pd( &mMinTime[lane], blend( _mm_loadu_pd( &mMinTime[lane] ), t, better ) );
+        _mm_storeu_pd( &mRaising[lane],
+          blend( _mm_loadu_pd( &mRaising[lane] ), _mm_and_pd( _mm_cmpge_pd( vZ, zero ), one ), better ) );
+        _mm_storeu_pd( &mBelow[lane],
+          blend( _mm_loadu_pd( &mBelow[lane] ), _mm_and_pd( _mm_cmplt_pd( z, tgtZ ), one ), better ) );
+        _mm_storeu_pd( &mNear[lane],
+          blend( _mm_loadu_pd( &mNear[lane] ), _mm_and_pd( nearMask, one ), better ) );
+      } // if
+
+      __m128d landed = _mm_cmple_pd( z, zero );
+      __m128d hit = _mm_cmplt_pd( distSq, radiusSumSq );
+      int doneBits = _mm_movemask_pd( _mm_or_pd( landed, hit ) );
+      if( 0 != doneBits )
+      {
+        int landedBits = _mm_movemask_pd( landed );
+        for( int k = 0; k < 2; ++k )
+        {
+          if( doneBits & ( 1 << k ) )
+            mDone[lane + k] = ( landedBits & ( 1 << k ) ) ? kLaneLanded : kLaneHit;
+        } // for
+        anyDone = true;
+      } // if
+
+    } // for
+
+    if( TickScalar( c, lane, to, actSimTime ) )
+      anyDone = true;
+
+    return anyDone;
+#else
+    return TickScalar( c, 0, to, actSimTime );
+#endif
+  } // CSimFireBatchRun::TickSSE2
+
+  //-------------------------------------------------------------------------------------------------
+
+#if defined( SIMFIRE_X86_64 )
+  SIMFIRE_TARGET_AVX2
+#endif
+  bool CSimFireBatchRun::TickAVX2( const BatchConsts_t & c, size_t to, double_t actSimTime )
+  {
+#if defined( SIMFIRE_X86_64 )
+    const __m256d dt = _mm256_set1_pd( c.dt );
+    const __m256d dtg = _mm256_set1_pd( c.dtg );
+    const __m256d dragCoef = _mm256_set1_pd( c.dragCoef );
+    const __m256d mass = _mm256_set1_pd( c.mass );
+    const __m256d tgtX = _mm256_set1_pd( c.tgtX );
+    const __m256d tgtY = _mm256_set1_pd( c.tgtY );
+    const __m256d tgtZ = _mm256_set1_pd( c.tgtZ );
+    const __m256d radiusSumSq = _mm256_set1_pd( c.radiusSumSq );
+    const __m256d nX = _mm256_set1_pd( c.nX );
+    const __m256d nY = _mm256_set1_pd( c.nY );
+    const __m256d nZ = _mm256_set1_pd( c.nZ );
+    const __m256d nD = _mm256_set1_pd( c.nD );
+    const __m256d t = _mm256_set1_pd( actSimTime );
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd( 1.0 );
+
+    bool anyDone = false;
+    size_t lane = 0;
+
+    for( ; lane + 4 <= to; lane += 4 )
+    {                   // Separate multiplications and additions are used on purpose (no FMA), so
+                        // rounding is the same as in scalar code.
+      __m256d vX = _mm256_loadu_pd( &mVX[lane] );
+      __m256d vY = _mm256_loadu_pd( &mVY[lane] );
+      __m256d vZ = _mm256_loadu_pd( &mVZ[lane] );
+
+      __m256d x = _mm256_add_pd( _mm256_loadu_pd( &mX[lane] ), _mm256_mul_pd( vX, dt ) );
+      __m256d y = _mm256_add_pd( _mm256_loadu_pd( &mY[lane] ), _mm256_mul_pd( vY, dt ) );
+      __m256d z = _mm256_add_pd( _mm256_loadu_pd( &mZ[lane] ), _mm256_mul_pd( vZ, dt ) );
+
+      if( 0.0 != c.dragCoef )
+      {
+        __m256d actV = _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( vX, vX ), _mm256_mul_pd( vY, vY ) ),
+                                      _mm256_mul_pd( vZ, vZ ) );
+        __m256d deltaV = _mm256_div_pd( _mm256_mul_pd( dragCoef, actV ), mass );
+        actV = _mm256_sqrt_pd( actV );
+        __m256d commonCoef = _mm256_div_pd( _mm256_sub_pd( actV, deltaV ), actV );
+        vX = _mm256_mul_pd( vX, commonCoef );
+        vY = _mm256_mul_pd( vY, commonCoef );
+        vZ = _mm256_mul_pd( vZ, commonCoef );
+      } // if
+
+      vZ = _mm256_sub_pd( vZ, dtg );
+
+      _mm256_storeu_pd( &mX[lane], x );
+      _mm256_storeu_pd( &mY[lane], y );
+      _mm256_storeu_pd( &mZ[lane], z );
+      _mm256_storeu_pd( &mVX[lane], vX );
+      _mm256_storeu_pd( &mVY[lane], vY );
+      _mm256_storeu_pd( &mVZ[lane], vZ );
+
+      __m256d distX = _mm256_sub_pd( x, tgtX );
+      __m256d distY = _mm256_sub_pd( y, tgtY );
+      __m256d distZ = _mm256_sub_pd( z, tgtZ );
+      __m256d distSq = _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( distX, distX ), _mm256_mul_pd( distY, distY ) ),
+                                      _mm256_mul_pd( distZ, distZ ) );
+
+      __m256d minDSq = _mm256_loadu_pd( &mMinDSq[lane] );
+      __m256d better = _mm256_cmp_pd( distSq, minDSq, _CMP_LT_OQ );
+      if( 0 != _mm256_movemask_pd( better ) )
+      {
+        __m256d bRefVal = _mm256_add_pd( _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( nX, x ), _mm256_mul_pd( nY, y ) ),
+                                                        _mm256_mul_pd( nZ, z ) ), nD );
+        __m256d nearMask = c.refNegative ? _mm256_cmp_pd( bRefVal, zero, _CMP_LT_OQ ) :
+                                           _mm256_cmp_pd( bRefVal, zero, _CMP_GT_OQ );
+
+        _mm256_storeu_pd( &mMinDSq[lane], _mm256_blendv_pd( minDSq, distSq, better ) );
+        _mm256_storeu_pd( &mMinTime[lane], _mm256_blendv_pd( _mm256_loadu_pd( &mMinTime[lane] ), t, better ) );
+        _mm256_storeu_pd( &mRaising[lane], _mm256_blendv_pd( _mm256_loadu_pd( &mRaising[lane] ),
+          _mm256_and_pd( _mm256_cmp_pd( vZ, zero, _CMP_GE_OQ ), one ), better ) );
+        _mm256_storeu_pd( &mBelow[lane], _mm256_blendv_pd( _mm256_loadu_pd( &mBelow[lane] ),
+          _mm256_and_pd( _mm256_cmp_pd( z, tgtZ, _CMP_LT_OQ ), one ), better ) );
+        _mm256_storeu_pd( &mNear[lane], _mm256_blendv_pd( _mm256_loadu_pd( &mNear[lane] ),
+          _mm256_and_pd( nearMask, one ), better ) );
+      } // if
+
+      __m256d landed = _mm256_cmp_pd( z, zero, _CMP_LE_OQ );
+      __m256d hit = _mm256_cmp_pd( distSq, radiusSumSq, _CMP_LT_OQ );
+      int doneBits = _mm256_movemask_pd( _mm256_or_pd( landed, hit ) );
+      if( 0 != doneBits )
+      {
+        int landedBits = _mm256_movemask_pd( landed );
+        for( int k = 0; k < 4; ++k )
+        {
+          if( doneBits & ( 1 << k ) )
+            mDone[lane + k] = ( landedBits & ( 1 << k ) ) ? kLaneLanded : kLaneHit;
+        } // for
+        anyDone = true;
+      } // if
+
+    } // for
+
+    if( TickScalar( c, lane, to, actSimTime ) )
+      anyDone = true;
+
+    return anyDone;
+#else
+    return TickScalar( c, 0, to, actSimTime );
+#endif
+  } // CSimFireBatchRun::TickAVX2
+
+  //-------------------------------------------------------------------------------------------------
+
+} // namespace SimFire
@@ -0,0 +1,175 @@
+//****************************************************************************************************
+//! \file CSimFireBatchRun.h
+//! Module contains declaration of CSimFireBatchRun class, which simulates a whole bunch of shots
+//! at once (in lockstep, using SIMD instructions).
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_CSimFireBatchRun
+#define H_CSimFireBatchRun
+
+#include <atomic>
+#include <span>
+
+#include <SimFireGlobals.h>
+#include <CSimFireSettings.h>
+#include <CSimFireSingleRunParams.h>
+#include <CSimFireSingleRun.h>
+
+namespace SimFire
+{
+
+  //***** CSimFireBatchRun ***************************************************************************
+
+  /*!  \brief This class simulates a bunch of shots with identical physics (they differ only in the aim
+       vector) in lockstep. Bullets are stored as structure of arrays, one lane per shot, and the tick
+       is evaluated by vectorized kernels (AVX2, SSE2 or plain scalar code, chosen at runtime). When
+       a bullet lands or hits the target, its lane is retired and the remaining lanes are compacted.
+
+       Arithmetic is performed in the same order as in processors of CSimFireSingleRun, so results
+       are bit-identical to the single run. Logging of individual ticks and export callbacks are not
+       supported, CSimFireSingleRun has to be used for them. */
+  class CSimFireBatchRun
+  {
+
+  public:
+
+    //------------------------------------------------------------------------------------------------
+    //! @name Constructors, destructor, clonning, assign operators
+    //@{----------------------------------------------------------------------------------------------
+
+    CSimFireBatchRun(
+      const CSimFireSettings & settings,
+      CSimFireSingleRun::LogCallback_t fnCall );
+
+    virtual ~CSimFireBatchRun();
+
+    //@}-----------------------------------------------------------------------------------------------
+    //! @name Public methods  */
+    //@{-----------------------------------------------------------------------------------------------
+
+    int Run( std::span<CSimFireSingleRunParams> runParams );
+    /*! \brief Runs all given simulations at once.
+
+        \param[in,out] runParams Parameters of the runs, output values are returned in these objects
+				\return 0 if all runs were successful, error code otherwise */
+
+    void SetCancelToken( std::atomic<bool> * cancelToken ) { mCancelToken = cancelToken; }
+    /*! \brief Sets cancellation token, see CSimFireSingleRun::SetCancelToken (all lanes still in
+        flight are cancelled at once).
+
+        \param[in] cancelToken Cancellation token, nullptr if runs cannot be cancelled */
+
+    SimdLevel_t GetSimdLevel() const { return mSimdLevel; }
+    //!< \brief Returns instruction set actually used by the tick kernel
+
+    static SimdLevel_t DetectSimdLevel();
+    /*!< \brief Returns best instruction set supported by the CPU (and operating system). */
+
+    static const std::string & GetStrValue( SimdLevel_t level );
+    /*!< \brief Returns string representation of given instruction set.
+
+         \param[in] level Instruction set
+         \return String representation of the instruction set */
+
+    //@}---------------------------------------------------------------------------------------------
+    //! @name Protected data
+    //@{----------------------------------------------------------------------------------------------
+
+  protected:
+
+    //! Lane ended in the last tick
+    enum LaneEnd_t: uint8_t
+    {
+      kLaneRunning      = 0,    //!< Bullet is still in flight
+      kLaneLanded       = 1,    //!< Bullet reached the ground
+      kLaneHit          = 2,    //!< Bullet hit the target
+      kLaneReceding     = 3,    //!< Bullet is provably receding from the target
+      kLaneCancelled    = 4     //!< Run was cancelled through the token
+    };
+
+    //! Constant physical parameters of the batch, shared by all lanes
+    struct BatchConsts_t
+    {
+      double_t dt;      //!< Time step [s]
+      double_t dtg;     //!< Time step * gravitational acceleration [m/s]
+      double_t dragCoef;//!< Time step * 1/2 * air density * Cd * cross section (0 in vacuum)
+      double_t mass;    //!< Mass of the bullet [kg]
+      double_t tgtX;    //!< X position of the target [m]
+      double_t tgtY;    //!< Y position of the target [m]
+      double_t tgtZ;    //!< Z position of the target [m]
+      double_t radiusSumSq;
+                        //!< Squared sum of bullet and target radii [m^2]
+      double_t nX;      //!< Half-space plane normal vector, X (see CSimFireSingleRun::Run)
+      double_t nY;      //!< Half-space plane normal vector, Y
+      double_t nZ;      //!< Half-space plane normal vector, Z
+      double_t nD;      //!< Half-space plane constant
+      bool refNegative; //!< Sign of the half-space plane equation at the shooter position
+      bool receding;    //!< If true, lanes receding from the target are retired (see ProvablyReceding)
+    };
+
+    bool TickScalar( const BatchConsts_t & c, size_t from, size_t to, double_t actSimTime );
+    /*!< \brief Evaluates one tick for lanes [from, to) by plain scalar code.
+
+         \param[in] c          Constant physical parameters of the batch
+         \param[in] from       First lane to be evaluated
+         \param[in] to         One past the last lane to be evaluated
+         \param[in] actSimTime Simulation time at the end of the tick [s]
+         \return true if any lane ended in this tick (see mDone) */
+
+    bool TickSSE2( const BatchConsts_t & c, size_t to, double_t actSimTime );
+    //!< \brief Same as TickScalar() for lanes [0, to), by SSE2 kernel (odd lane by scalar code)
+
+    bool TickAVX2( const BatchConsts_t & c, size_t to, double_t actSimTime );
+    //!< \brief Same as TickScalar() for lanes [0, to), by AVX2 kernel (remaining lanes by scalar code)
+
+    void RetireLane( size_t lane, size_t & nActive, uint64_t ticks, double_t actSimTime );
+    //!< \brief Stores results of finished lane and moves the last active lane into its place
+
+    bool IsLogEnabled( LogLevel_t level ) const
+      { return gLogFloor <= level && nullptr != mLogCallback && mSettings.GetLogLevel() <= level; }
+    //!< \brief Returns true if messages of given level are logged (see SIMFIRE_LOG)
+
+    void WriteLogMessage( LogLevel_t level, const std::string & id, const std::string & mssg )
+      { mLogCallback( level, id, mssg ); }
+    //!< \brief Passes the message to the logging callback (see SIMFIRE_LOG)
+
+    const CSimFireSettings & mSettings;
+		//<! Reference to settings object, which contains all parameters entered by user on startup
+
+    CSimFireSingleRun::LogCallback_t mLogCallback;
+		//!< Callback method for logging messages
+
+    SimdLevel_t mSimdLevel;
+    //!< Instruction set used by the tick kernel
+
+    std::atomic<bool> * mCancelToken;
+    //!< Token cancelling the runs when set, nullptr if not cancellable
+
+    CSimFireSingleRunParams * mRunParams;
+    //!< Run parameters of the batch being processed
+
+    std::vector<double_t> mX;       //!< X positions of bullets (one lane per run) [m]
+    std::vector<double_t> mY;       //!< Y positions of bullets [m]
+    std::vector<double_t> mZ;       //!< Z positions of bullets [m]
+    std::vector<double_t> mVX;      //!< X velocities of bullets [m/s]
+    std::vector<double_t> mVY;      //!< Y velocities of bullets [m/s]
+    std::vector<double_t> mVZ;      //!< Z velocities of bullets [m/s]
+    std::vector<double_t> mMinDSq;  //!< Minimal squared distances to the target [m^2]
+    std::vector<double_t> mMinTime; //!< Times of minimal distances [s]
+    std::vector<double_t> mRaising; //!< 1.0 if the bullet was rising at the minimal distance
+    std::vector<double_t> mBelow;   //!< 1.0 if the bullet was below the target at the minimal distance
+    std::vector<double_t> mNear;    //!< 1.0 if the bullet was in shooter's half-plane at the minimal distance
+    std::vector<uint8_t> mDone;     //!< Lane end status after the last tick (see LaneEnd_t)
+    std::vector<size_t> mLaneRun;   //!< Index of the run (in mRunParams) simulated in the lane
+
+    //@}
+
+  }; // CSimFireBatchRun
+
+} // namespace SimFire
+
+#endif
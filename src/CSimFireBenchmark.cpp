@@ -0,0 +1,369 @@
+//****************************************************************************************************
+//! \file CSimFireBenchmark.cpp
+//! Module contains definitions of CSimFireBenchmark class, declared in CSimFireBenchmark.h, which
+//! compares accuracy and cost of available integration methods on a given scenario.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <chrono>
+#include <thread>
+
+#include <SimFireRandom.h>
+#include <SimFireStringTools.h>
+#include <CSimFireCore.h>
+#include <CSimFireSingleRun.h>
+#include <CSimFireWorkerPool.h>
+#include <CSimFireBenchmark.h>
+
+namespace SimFire
+{
+
+  const double_t CSimFireBenchmark::mDtFactors[] = { 0.5, 1.0, 2.0, 5.0, 10.0 };
+
+  const size_t CSimFireBenchmark::mBreedingPopulations[] = { 40, 400, 4000, 40000, 100000 };
+
+  const IntegratorType_t CSimFireBenchmark::mFixedStepSchemes[] = {
+    IntegratorType_t::kEuler,
+    IntegratorType_t::kSymplecticEuler,
+    IntegratorType_t::kVelocityVerlet,
+    IntegratorType_t::kRungeKutta4 };
+
+  //****** CSimFireBenchmark *************************************************************************
+
+  CSimFireBenchmark::CSimFireBenchmark( const CSimFireSettings & settings ):
+    mSettings( settings )
+  {}
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireBenchmark::~CSimFireBenchmark() = default;
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireBenchmark::PrepareShots( std::vector<CSimFireSingleRunParams> & runs ) const
+  {
+    runs.resize( mSettings.GetAimZSteps() );
+
+    double_t zAct = mSettings.GetAimZStart();
+    double_t increment = ( mSettings.GetAimZEnd() - mSettings.GetAimZStart() ) / mSettings.GetAimZSteps();
+
+    for( auto & run : runs )
+    {
+      run.Reset();
+      run.mRunLabel = CSimFireSingleRunParams::RunLabel_t::kBench;
+      run.mThreadLabel = CSimFireSingleRunParams::ThreadLabel_t::kMain;
+      run.mVelocityXCoef = mSettings.GetAimX();
+      run.mVelocityYCoef = mSettings.GetAimY();
+      run.mVelocityZCoef = zAct;
+      zAct += increment;
+    } // for
+
+  } // CSimFireBenchmark::PrepareShots
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireBenchmark::BenchResult_t CSimFireBenchmark::RunShots(
+    IntegratorType_t integrator,
+    double_t dt,
+    double_t atol,
+    double_t rtol )
+  {
+    CSimFireSettings settings( mSettings );
+    settings.mIntegrator = integrator;
+    settings.mdt = dt;
+    settings.mAbsTolerance = atol;
+    settings.mRelTolerance = rtol;
+    settings.mSubTickApproach = true;
+                        // Closest approach sampled at the end of ticks would be quantized by about
+                        // velocity * dt, which hides the error of the integrator itself
+    settings.mLogInterval = 0.0;
+
+    CSimFireSingleRun runWorker( settings, nullptr );
+
+    BenchResult_t result{ {}, 0.0, 0.0, 0 };
+    PrepareShots( result.runs );
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for( auto & run : result.runs )
+      runWorker.Run( run );
+
+    auto endTime = std::chrono::steady_clock::now();
+
+    result.wallTime = (double_t)std::chrono::duration_cast<std::chrono::nanoseconds>( endTime - startTime ).count();
+    for( auto & run : result.runs )
+    {
+      result.simTime += run.mSimTime;
+      result.steps += run.mSteps;
+    } // for
+
+    return result;
+
+  } // CSimFireBenchmark::RunShots
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireBenchmark::RunScheduling( std::ostream & out )
+  {
+    CSimFireSettings settings( mSettings );
+    settings.mLogInterval = 0.0;
+
+    uint32_t nThreads = ( settings.GetNumberOfThreads() > 0 ) ?
+      static_cast<uint32_t>( settings.GetNumberOfThreads() ) :
+      std::max( 1u, std::thread::hardware_concurrency() );
+
+    CSimFireWorkerPool pool( nThreads );
+    std::vector<std::unique_ptr<CSimFireSingleRun>> runWorkers;
+    for( uint32_t workerIdx = 0; workerIdx < pool.GetNumberOfWorkers(); ++workerIdx )
+      runWorkers.push_back( std::make_unique<CSimFireSingleRun>( settings, nullptr ) );
+
+    std::vector<CSimFireSingleRunParams> runs;
+
+    std::vector<double_t> costs;
+    std::vector<size_t> order;
+    std::vector<size_t> partEnds;
+
+    auto runJob = [&]( ScheduleType_t schedule )
+    {                   // Shots of the sweep are ordered by elevation, so costly high arc shots are
+                        // neighbours and static schedule gives them all to the same threads.
+      PrepareShots( runs );
+
+      if( ScheduleType_t::kLongestFirst == schedule )
+      {                 // Costs are predicted from the aim vectors (vacuum flight time)
+        costs.clear();
+        for( auto & run : runs )
+          costs.push_back( CSimFireSingleRun::EstimateFlightTime( settings, run ) );
+        CSimFireWorkerPool::PartitionLongestFirst( costs, pool.GetNumberOfWorkers(), order, partEnds );
+
+        return pool.ForEachPart( partEnds, [&]( size_t first, size_t last, uint32_t workerIdx )
+        {
+          for( size_t i = first; i < last; ++i )
+            runWorkers[workerIdx]->Run( runs[order[i]] );
+        } );
+      } // if
+
+      return pool.ForEachRange( runs.size(), schedule, 1, [&]( size_t first, size_t last, uint32_t workerIdx )
+      {
+        for( size_t i = first; i < last; ++i )
+          runWorkers[workerIdx]->Run( runs[i] );
+      } );
+    };
+
+    runJob( ScheduleType_t::kDynamic );
+                        // Warm-up of threads and run workers
+
+    out << FormatStr( "Scheduling of %zu shots among %u threads:", runs.size(), pool.GetNumberOfWorkers() )
+        << std::endl << std::endl;
+    out << FormatStr( "%-12s %14s %18s %10s", "Schedule", "Wall [ms]", "Barrier idle [ms]", "Idle [%]" ) << std::endl;
+
+    for( auto schedule : { ScheduleType_t::kStatic, ScheduleType_t::kDynamic, ScheduleType_t::kLongestFirst } )
+    {
+      auto stats = runJob( schedule );
+      out << FormatStr( "%-12s %14.3f %18.3f %10.1f", CSimFireWorkerPool::GetStrValue( schedule ),
+        1000.0 * stats.wallTime, 1000.0 * stats.barrierIdle,
+        100.0 * stats.barrierIdle / std::max( gAlmostZero, stats.wallTime * pool.GetNumberOfWorkers() ) ) << std::endl;
+    } // for
+
+    out << std::endl;
+
+  } // CSimFireBenchmark::RunScheduling
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireBenchmark::RunBreeding( std::ostream & out )
+  {
+    CSimFireSettings settings( mSettings );
+    settings.mLogInterval = 0.0;
+
+    CSimFireCore core( settings );
+    core.mSeed = (uint64_t)std::max<int64_t>( 0, settings.GetSeed() );
+    core.PrepareWorkers();
+
+    CSimFireCore::ListOfRunDescriptors_t population;
+    CSimFireCore::ListOfRunDescriptors_t serial;
+    CSimFireCore::ListOfRunDescriptors_t parallel;
+
+    out << FormatStr( "Breeding of one generation (%u threads for parallel breeding):",
+      core.mWorkerPool->GetNumberOfWorkers() ) << std::endl << std::endl;
+    out << FormatStr( "%-12s %14s %14s %14s %10s", "Population", "Serial [us]", "Parallel [us]", "ns/run", "Same" )
+        << std::endl;
+
+    for( size_t nRuns : mBreedingPopulations )
+    {                   // Synthetic results: random elevations, distances and flags of the closest approach
+      population.resize( nRuns );
+      double_t avgDist = 0.0;
+      for( size_t runIdx = 0; runIdx < nRuns; ++runIdx )
+      {
+        auto & run = population[runIdx];
+        auto random = [&]( uint32_t draw ) { return RandomUniform( core.mSeed, nRuns, (uint32_t)runIdx, draw ); };
+
+        run.Reset();
+        run.mRunNr = (uint32_t)( runIdx + 1 );
+        run.mVelocityXCoef = settings.GetTgtX() - settings.GetGunX();
+        run.mVelocityYCoef = settings.GetTgtY() - settings.GetGunY();
+        run.mVelocityZCoef = ( settings.GetTgtZ() - settings.GetGunZ() ) + 100.0 * random( 0 );
+        run.mMinDTgtSq = std::pow( 100.0 * random( 1 ), 2 );
+        run.mRaising = random( 2 ) < 0.3;
+        run.mBelow = random( 3 ) < 0.5;
+        run.mNearHalfPlane = random( 4 ) < 0.5;
+        run.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kEndedNoActive;
+        avgDist += std::sqrt( run.mMinDTgtSq );
+      } // for
+      avgDist /= (double_t)nRuns;
+
+      size_t repeats = std::max<size_t>( 1, 400000 / nRuns );
+      auto timeBreeding = [&]( CSimFireCore::ListOfRunDescriptors_t & runs, bool inParallel )
+      {                 // Population is restored before each breeding, only the breeding is timed
+        std::chrono::steady_clock::duration total{};
+        for( size_t repeat = 0; repeat < repeats; ++repeat )
+        {
+          runs = population;
+          auto start = std::chrono::steady_clock::now();
+          core.BreedGeneration( runs, avgDist, 1, inParallel );
+          total += std::chrono::steady_clock::now() - start;
+        } // for
+        return 1e6 * std::chrono::duration<double_t>( total ).count() / (double_t)repeats;
+      };
+
+      double_t serialTime = timeBreeding( serial, false );
+      double_t parallelTime = timeBreeding( parallel, true );
+
+      bool same = true;
+      for( size_t runIdx = 0; runIdx < nRuns && same; ++runIdx )
+        same = serial[runIdx].mVelocityXCoef == parallel[runIdx].mVelocityXCoef &&
+               serial[runIdx].mVelocityYCoef == parallel[runIdx].mVelocityYCoef &&
+               serial[runIdx].mVelocityZCoef == parallel[runIdx].mVelocityZCoef;
+                        // Parallel breeding must not change the result
+
+      out << FormatStr( "%-12zu %14.3f %14.3f %14.1f %10s", nRuns, serialTime, parallelTime,
+        1000.0 * std::min( serialTime, parallelTime ) / (double_t)nRuns, same ? "yes" : "NO" ) << std::endl;
+    } // for
+
+    out << std::endl;
+
+  } // CSimFireBenchmark::RunBreeding
+
+  //-------------------------------------------------------------------------------------------------
+
+  bool CSimFireBenchmark::SameClassification( const CSimFireSingleRunParams & a, const CSimFireSingleRunParams & b )
+  {
+    if( a.mReturnCode != b.mReturnCode )
+      return false;
+    if( CSimFireSingleRunParams::SimResCode_t::kEndedCollision == a.mReturnCode )
+      return true;      // Flags of a hit are not significant
+    return ( a.mRaising == b.mRaising && a.mNearHalfPlane == b.mNearHalfPlane && a.mBelow == b.mBelow );
+  } // CSimFireBenchmark::SameClassification
+
+  //-------------------------------------------------------------------------------------------------
+
+  bool CSimFireBenchmark::Run( std::ostream & out )
+  {
+    if( 0 == mSettings.GetAimZSteps() )
+    {
+      out << "Benchmark needs shots of the test sweep, section [test] (aimZSteps) is empty." << std::endl;
+      return false;
+    } // if
+
+    auto reference = RunShots( IntegratorType_t::kDormandPrince, mSettings.GetDt(), 1e-10, 1e-13 );
+                        // Reference solution, adaptive integrator with tolerances far below errors
+                        // of any tested configuration
+
+    uint32_t refHits = 0;
+    for( auto & run : reference.runs )
+      if( CSimFireSingleRunParams::SimResCode_t::kEndedCollision == run.mReturnCode )
+        ++refHits;
+
+    out << FormatStr( "Benchmark: %u shots (%u hits in reference solution)", mSettings.GetAimZSteps(), refHits )
+        << std::endl << std::endl;
+    out << FormatStr( "%-12s %12s %12s %14s %14s %10s %14s",
+      "Integrator", "dt [s]", "Steps/shot", "MaxErr [m]", "MeanErr [m]", "Changed", "ns/sim. s" ) << std::endl;
+
+    auto printResult = [&]( IntegratorType_t integrator, double_t dt, const BenchResult_t & res ) -> uint32_t
+    {
+      double_t maxErr = 0.0;
+      double_t sumErr = 0.0;
+      uint32_t nrMiss = 0;
+      uint32_t changed = 0;
+
+      for( size_t i = 0; i < res.runs.size(); ++i )
+      {
+        auto & run = res.runs[i];
+        auto & ref = reference.runs[i];
+
+        if( ! SameClassification( run, ref ) )
+          ++changed;
+
+        if( CSimFireSingleRunParams::SimResCode_t::kEndedCollision != run.mReturnCode &&
+            CSimFireSingleRunParams::SimResCode_t::kEndedCollision != ref.mReturnCode )
+        {               // Miss distance is comparable only if both shots missed the target
+          double_t err = std::fabs( std::sqrt( run.mMinDTgtSq ) - std::sqrt( ref.mMinDTgtSq ) );
+          maxErr = std::max( maxErr, err );
+          sumErr += err;
+          ++nrMiss;
+        } // if
+      } // for
+
+      std::string maxErrStr( "n/a" );
+      std::string meanErrStr( "n/a" );
+      if( 0 < nrMiss )
+      {                 // Without a shot missed in both solutions there is no error to report
+        maxErrStr = FormatStr( "%.6e", maxErr );
+        meanErrStr = FormatStr( "%.6e", sumErr / nrMiss );
+      } // if
+
+      out << FormatStr( "%-12s %12.6f %12.1f %14s %14s %10u %14.1f",
+        GetStrValue( integrator ), dt,
+        (double_t)res.steps / (double_t)res.runs.size(),
+        maxErrStr, meanErrStr,
+        changed,
+        IsPositive( res.simTime ) ? res.wallTime / res.simTime : 0.0 ) << std::endl;
+
+      return changed;
+    };
+
+    std::vector<std::pair<IntegratorType_t, double_t>> largestStableDt;
+
+    for( auto scheme : mFixedStepSchemes )
+    {
+      double_t stableDt = 0.0;
+      bool stable = true;
+
+      for( auto factor : mDtFactors )
+      {
+        double_t dt = mSettings.GetDt() * factor;
+        auto res = RunShots( scheme, dt, mSettings.GetAbsTolerance(), mSettings.GetRelTolerance() );
+        if( 0 != printResult( scheme, dt, res ) )
+          stable = false;
+        else if( stable )
+          stableDt = dt;
+      } // for
+
+      largestStableDt.emplace_back( scheme, stableDt );
+    } // for
+
+    auto adaptive = RunShots( IntegratorType_t::kDormandPrince, mSettings.GetDt(),
+      mSettings.GetAbsTolerance(), mSettings.GetRelTolerance() );
+    printResult( IntegratorType_t::kDormandPrince, mSettings.GetDt(), adaptive );
+
+    out << std::endl << "Largest time step keeping classification of all shots:" << std::endl;
+    for( auto & item : largestStableDt )
+    {
+      if( IsPositive( item.second ) )
+        out << FormatStr( "  %-12s %.6f s", GetStrValue( item.first ), item.second ) << std::endl;
+      else
+        out << FormatStr( "  %-12s none of tested", GetStrValue( item.first ) ) << std::endl;
+    } // for
+
+    out << std::endl;
+
+    RunScheduling( out );
+    RunBreeding( out );
+
+    return true;
+
+  } // CSimFireBenchmark::Run
+
+} // namespace SimFire
@@ -0,0 +1,123 @@
+//****************************************************************************************************
+//! \file CSimFireBenchmark.h
+//! Module contains declaration of CSimFireBenchmark class, which compares accuracy and cost of
+//! available integration methods on a given scenario.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_CSimFireBenchmark
+#define H_CSimFireBenchmark
+
+#include <iostream>
+
+#include <SimFireGlobals.h>
+#include <SimFireIntegrators.h>
+#include <CSimFireSettings.h>
+#include <CSimFireSingleRunParams.h>
+
+namespace SimFire
+{
+
+  //***** CSimFireBenchmark **************************************************************************
+
+  /*!  \brief This class runs shots of the test sweep (section [test] of the INI file) with each
+       fixed-step scheme at several time steps and with the adaptive integrator. Results are compared
+       with a reference solution (adaptive integrator with very tight tolerances): error of the miss
+       distance, number of shots whose classification (hit, miss and its flags) differs and cost in
+       nanoseconds of wall time per second of simulated time. The largest time step keeping the
+       classification of all shots stable is reported for each scheme.
+
+       Then the shots are distributed among worker threads with static and dynamic schedule and
+       time the threads spent idle at the final barrier is compared. Finally cost of breeding of one
+       generation of the genetic algorithm is measured for populations of several sizes. */
+  class CSimFireBenchmark
+  {
+
+  public:
+
+    //------------------------------------------------------------------------------------------------
+    //! @name Constructors, destructor, clonning, assign operators
+    //@{----------------------------------------------------------------------------------------------
+
+    CSimFireBenchmark( const CSimFireSettings & settings );
+
+    virtual ~CSimFireBenchmark();
+
+    //@}-----------------------------------------------------------------------------------------------
+    //! @name Public methods  */
+    //@{-----------------------------------------------------------------------------------------------
+
+    bool Run( std::ostream & out = std::cout );
+    /*!< \brief Runs the benchmark and prints results to given output stream.
+
+         \param[in,out] out Output stream, default is std::cout
+         \return true if the benchmark was successful, false otherwise */
+
+    //@}---------------------------------------------------------------------------------------------
+    //! @name Protected data
+    //@{----------------------------------------------------------------------------------------------
+
+  protected:
+
+    //! Results of all shots simulated with one integrator and time step
+    struct BenchResult_t
+    {
+      std::vector<CSimFireSingleRunParams> runs;
+                        //!< Parameters and results of individual shots
+      double_t wallTime;//!< Wall time of all shots [ns]
+      double_t simTime; //!< Simulated time of all shots [s]
+      uint64_t steps;   //!< Integration steps of all shots
+    };
+
+    BenchResult_t RunShots( IntegratorType_t integrator, double_t dt, double_t atol, double_t rtol );
+    /*!< \brief Simulates all shots of the test sweep with given integrator.
+
+         \param[in] integrator Integration method
+         \param[in] dt         Time step (first trial step for adaptive integrator) [s]
+         \param[in] atol       Absolute tolerance (adaptive integrator only)
+         \param[in] rtol       Relative tolerance (adaptive integrator only)
+         \return Results of all shots */
+
+    void PrepareShots( std::vector<CSimFireSingleRunParams> & runs ) const;
+    /*!< \brief Fills parameters of all shots of the test sweep.
+
+         \param[out] runs Parameters of the shots */
+
+    void RunScheduling( std::ostream & out );
+    /*!< \brief Simulates all shots of the test sweep by worker threads with each schedule and prints
+         wall time and idle time of threads at the final barrier.
+
+         \param[in,out] out Output stream */
+
+    void RunBreeding( std::ostream & out );
+    /*!< \brief Breeds following generation from synthetic populations of several sizes, serially and
+         by worker threads, and prints wall time of one breeding. Both results are checked to be the
+         same.
+
+         \param[in,out] out Output stream */
+
+    static bool SameClassification( const CSimFireSingleRunParams & a, const CSimFireSingleRunParams & b );
+    //!< \brief Returns true if both runs ended in the same way (hit or miss with the same flags)
+
+    const CSimFireSettings & mSettings;
+		//<! Reference to settings object, which contains all parameters entered by user on startup
+
+    static const double_t mDtFactors[];
+    //!< Multiples of the time step from settings to be tested (ascending)
+
+    static const IntegratorType_t mFixedStepSchemes[];
+    //!< Fixed-step schemes to be tested
+
+    static const size_t mBreedingPopulations[];
+    //!< Sizes of populations for breeding benchmark
+
+    //@}
+
+  }; // CSimFireBenchmark
+
+} // namespace SimFire
+
+#endif
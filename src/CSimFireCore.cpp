@@ -8,20 +8,74 @@
 // 19. 11. 2025, V. Pospíšil, gdermog@seznam.cz                                                     
 //****************************************************************************************************
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
 #include <thread>
 
+#include <SimFireProfiler.h>
+#include <SimFireRandom.h>
 #include <SimFireStringTools.h>
 #include <CSimFireCore.h>
+#include <CSimFireBatchRun.h>
 
 
 namespace SimFire
 {
 
+   constexpr double_t kDecCoef = 0.5;
+   constexpr double_t kIncCoef = 1.5;
+                        // Weights of parents of recombined runs, also sizes of mutation (increase or
+                        // decrease of elevation)
+
+   constexpr double_t kMutationCoefs[] = { kIncCoef, kDecCoef, kDecCoef, kIncCoef };
+                        // Size of mutation of leftovers of each miss category (see MissCategory_t)
+
+   constexpr double_t kFineTuneCoef = 0.015;
+   constexpr double_t kFineTuneDecay = 0.9;
+                        // Relative change of elevation of spawned runs, decays with each generation
+
+   constexpr double_t kZRatioRnd = 0.25;
+                        // Relative spread of elevation of random runs
+
+   constexpr double_t kAvgDistCutCoef = 1.5;
+                        // Runs farther than this multiple of the average distance are not bred from
+
+   constexpr size_t kSpawners = 2;
+                        // Number of the best runs of each category spawned from
+
+   constexpr size_t kParallelBreedingMin = 4096;
+                        // Smaller generations are bred serially, waking up the pool would cost more
+
    //****** CCSimFireCore ****************************************************************************
 
    CSimFireCore::CSimFireCore( const CSimFireSettings & settings ):
-     mSettings( settings )
+     mSettings( settings ),
+     mLogger(),
+     mRunWorkers(),
+     mBatchWorkers(),
+     mSeed( 0 ),
+     mCancelRuns( false ),
+     mDeadlinePassed( false ),
+     mBestRun(),
+     mStagnantGenerations( 0 ),
+     mStopReason( StopReason_t::kNone ),
+     mEvalCache(),
+     mTelemetry(),
+     mTracer(),
+     mMeasuredCosts(),
+     mBreedingRecords(),
+     mCategoryBegin{},
+     mCategoryEnd{},
+     mBreedingPlan(),
+     mWorkerPool()
    {
+     if( 0 < mSettings.GetLogBuffer() )
+       mLogger = std::make_unique<CSimFireLogger>( std::cout, mSettings.GetLogBuffer(), mSettings.GetLogOverflow() );
 
    } /* CSimFireCore::CSimFireCore */
 
@@ -33,80 +87,292 @@ namespace SimFire
 
    //-------------------------------------------------------------------------------------------------
 
-   bool CSimFireCore::Run()
+   void CSimFireCore::PrepareTelemetry()
    {
-     if( mSettings.GetSeed() < 0 )
-       std::srand( (unsigned)std::time( {} ) );
+     mTelemetry.reset();
+     if( mSettings.GetTelemetryFile().empty() )
+       return;
+
+     mTelemetry = std::make_unique<CSimFireTelemetry>( mSettings.GetTelemetryFile(), mSettings.GetTelemetryFormat() );
+     if( !mTelemetry->IsOpen() )
+     {
+       SIMFIRE_LOG( *this, LogLevel_t::kWarning, "CORE", "Telemetry file %s cannot be created, telemetry is not exported",
+         mSettings.GetTelemetryFile() );
+       mTelemetry.reset();
+       return;
+     } // if
+
+     mTelemetry->WriteSetup( mSettings.GetSimIdentifier(), mSeed, mWorkerPool->GetNumberOfWorkers(),
+       mSettings.GetSteadyState() ? "steady" : CSimFireWorkerPool::GetStrValue( mSettings.GetSchedule() ) );
+
+   } // CSimFireCore::PrepareTelemetry
+
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::AddRunToTelemetry( CSimFireTelemetry::Record_t & record, const CSimFireSingleRunParams & item )
+   {
+     if( CSimFireSingleRunParams::SimResCode_t::kError == item.mReturnCode )
+       ++record.errors;
+     else if( !IsRunCompleted( item ) )
+       ++record.cancelled;
      else
-       std::srand( mSettings.GetSeed() );
+     {                  // Only completed runs have final distance, cancelled ones keep the initial one
+       if( CSimFireSingleRunParams::SimResCode_t::kEndedCollision == item.mReturnCode )
+         ++record.hits;
+       auto dist = std::sqrt( item.mMinDTgtSq );
+       record.bestMiss = std::min( record.bestMiss, dist );
+       record.avgMiss += dist;
+                        // Sum of distances until WriteTelemetry
+     } // else
+   } // CSimFireCore::AddRunToTelemetry
 
-     //------- Preparing threads and workers for parallel simulations --------------------------------
+   //-------------------------------------------------------------------------------------------------
 
-     auto nrOfRuns = mSettings.GetRunsInGeneration();
+   void CSimFireCore::WriteTelemetry( CSimFireTelemetry::Record_t & record, const ListOfRunDescriptors_t & population )
+   {
+     size_t nCompleted = record.runs - record.cancelled - record.errors;
+     if( 0 < nCompleted )
+       record.avgMiss /= (double_t)nCompleted;
+     else
+       record.avgMiss = std::numeric_limits<double_t>::max();
+                        // Not defined, written as null (see CSimFireTelemetry::WriteRecord)
+     record.spread = SurvivorsSpread( population );
 
-     if( 0 == nrOfRuns )
-     {
-       WriteLogMessage( "CORE", "No runs to perform (number of runs is set to zero)" );
-       return false;
-     } // if
+     mTelemetry->WriteRecord( record );
+
+   } // CSimFireCore::WriteTelemetry
+
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::PrepareTracer()
+   {
+     mTracer.reset();
+     if( mSettings.GetTraceFile().empty() )
+       return;
+
+     mTracer = std::make_unique<CSimFireTracer>();
+     mTracer->SetTrackName( 0, "CORE" );
+     for( uint32_t workerIdx = 0; workerIdx < mWorkerPool->GetNumberOfWorkers(); ++workerIdx )
+       mTracer->SetTrackName( workerIdx + 1, FormatStr( "THRD_%02u", workerIdx + 1 ) );
+                        // Track of a worker is its index + 1, the main thread has track 0
+
+   } // CSimFireCore::PrepareTracer
+
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::FinishTracer()
+   {
+     if( !mTracer )
+       return;
+
+     if( mTracer->WriteFile( mSettings.GetTraceFile() ) )
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "Timeline of %zu spans written to %s",
+         mTracer->GetSpanCount(), mSettings.GetTraceFile() );
+     else
+       SIMFIRE_LOG( *this, LogLevel_t::kWarning, "CORE", "Timeline cannot be written to %s",
+         mSettings.GetTraceFile() );
+
+     mTracer.reset();
+
+   } // CSimFireCore::FinishTracer
+
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::PrepareWorkers()
+   {
+     if( mWorkerPool )
+       return;          // Threads and their run workers live as long as the core, generations are only
+                        // queued to them
 
      uint32_t nThreads = ( mSettings.GetNumberOfThreads() > 0 ) ?
        static_cast<uint32_t>( mSettings.GetNumberOfThreads() ) :
        std::max( 1u, std::thread::hardware_concurrency() );
 
-     std::vector<std::future<void>> vRunFutures( nThreads, {} );
-     std::vector<std::string> vRunThreadIds( nThreads, {} );
+     mWorkerPool = std::make_unique<CSimFireWorkerPool>( nThreads );
+     for( uint32_t workerIdx = 0; workerIdx < mWorkerPool->GetNumberOfWorkers(); ++workerIdx )
+     {
+       mRunWorkers.push_back( std::make_unique<CSimFireSingleRun>( mSettings,
+         BIND_SINGLE_RUN_LOG_CALLBACK( this, CSimFireCore::WriteLogMessage ) ) );
+       mRunWorkers.back()->SetCancelToken( &mCancelRuns );
+     } // for
+     mBatchWorkers.resize( mRunWorkers.size() );
 
-     ListOfRunDescriptors_t vRunParams( nrOfRuns, {} );
-     std::vector<std::pair<ListOfRunDescriptors_t::iterator, ListOfRunDescriptors_t::iterator>> 
-       vRunParamsPerThreadBunch( nThreads, {} );
-                        // For each simulation there is a set of parameters. Simulations are divided 
-                        // into bunches, each of them is processed by one thread. vRunParams vectors 
-                        // holds all parameter setss for all simulations, vRunParamsPerThreadBunch 
-                        // holds division of vRunParams into bunches for each thread.
+   } // CSimFireCore::PrepareWorkers
 
-     uint32_t itemsPerBatch = nrOfRuns / nThreads;
-     uint32_t itemsPerBatchRest = nrOfRuns % nThreads;
+   //-------------------------------------------------------------------------------------------------
 
-     size_t firstItem = 0;
-     size_t lastItem = 0;
+   bool CSimFireCore::Run()
+   {
+     if constexpr( gProcessorProfiling )
+       ResetProcProfiles();
 
-     for( size_t thrdIdx = 0; thrdIdx < nThreads; ++thrdIdx )
-     {                  // Prepare bunch of runs for each thread (by separating dedicated parameter  
-                        // sets into individual groups)
+     bool result = RunSimulation();
 
-       lastItem = firstItem + itemsPerBatch;
-       if( 0 < itemsPerBatchRest )
-       {
-         ++lastItem;
-         --itemsPerBatchRest;
-       } // if
+     if constexpr( gProcessorProfiling )
+       LogProcessorProfiles();
 
-       if( nrOfRuns <= firstItem )
-         break;
+     if( mLogger )
+     {
+       mLogger->Flush();
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "Log writer: %zu messages written, %zu dropped (%s on overflow)",
+         (size_t)mLogger->GetWritten(), (size_t)mLogger->GetDropped(),
+         CSimFireLogger::GetStrValue( mSettings.GetLogOverflow() ) );
+       mLogger->Flush(); // Everything logged by the run is printed before the caller continues
+     } // if
 
-       auto bPars = vRunParams.begin();
-       std::advance( bPars, firstItem );
+     return result;
 
-       auto ePars = vRunParams.begin();
-       if( lastItem < nrOfRuns )
-         std::advance( ePars, lastItem );
-       else
-         ePars = vRunParams.end();
+   } // CSimFireCore::Run
 
-       vRunThreadIds[thrdIdx] = FormatStr( "THRD_%02u", thrdIdx + 1 );
-       vRunParamsPerThreadBunch[thrdIdx] = std::make_pair( bPars, ePars );
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::LogProcessorProfiles()
+   {
+     auto profiles = CollectProcProfiles();
+
+     ProcProfile_t total;
+     total.fill( ProcCounters_t{ 0, 0, 0 } );
+     uint64_t totalNanoseconds = 0;
+     for( const auto & profile : profiles )
+       for( size_t proc = 0; proc < total.size(); ++proc )
+       {
+         total[proc].ticks += profile[proc].ticks;
+         total[proc].nanoseconds += profile[proc].nanoseconds;
+         total[proc].cycles += profile[proc].cycles;
+         totalNanoseconds += profile[proc].nanoseconds;
+       } // for
+
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "Processor profile (%zu threads):", profiles.size() );
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "%-10s %12s %12s %10s %12s %12s %8s",
+       "Processor", "Ticks", "Wall [ms]", "ns/tick", "Mcycles", "cycles/tick", "Share" );
+     for( size_t proc = 0; proc < total.size(); ++proc )
+     {
+       const auto & counters = total[proc];
+       if( 0 == counters.ticks )
+         continue;      // Processor is not part of chosen pipeline
+
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "%-10s %12zu %12.3f %10.1f %12.3f %12.1f %7.1f%%",
+         SimFire::GetStrValue( (ProfiledProc_t)proc ), (size_t)counters.ticks, 1e-6 * (double_t)counters.nanoseconds,
+         (double_t)counters.nanoseconds / (double_t)counters.ticks, 1e-6 * (double_t)counters.cycles,
+         (double_t)counters.cycles / (double_t)counters.ticks,
+         100.0 * (double_t)counters.nanoseconds / (double_t)std::max<uint64_t>( 1, totalNanoseconds ) );
+     } // for
 
-       firstItem = lastItem;
+     for( size_t thread = 0; thread < profiles.size(); ++thread )
+     {
+       uint64_t nanoseconds = 0;
+       uint64_t cycles = 0;
+       for( const auto & counters : profiles[thread] )
+       {
+         nanoseconds += counters.nanoseconds;
+         cycles += counters.cycles;
+       } // for
 
+       if( 0 < nanoseconds )
+         SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "Thread %zu: %.3f ms, %.3f Mcycles in processors",
+           thread + 1, 1e-6 * (double_t)nanoseconds, 1e-6 * (double_t)cycles );
      } // for
 
+   } // CSimFireCore::LogProcessorProfiles
+
+   //-------------------------------------------------------------------------------------------------
+
+   bool CSimFireCore::RunSimulation()
+   {
+     if( mSettings.GetSeed() < 0 )
+       mSeed = (uint64_t)std::time( {} );
+     else
+       mSeed = (uint64_t)mSettings.GetSeed();
+
+     mBestRun = CSimFireSingleRunParams();
+     mBestRun.Reset();
+     mStagnantGenerations = 0;
+     mStopReason = StopReason_t::kNone;
+     mDeadlinePassed.store( false );
+
+     if( IntegratorType_t::kAnalytic == mSettings.GetIntegrator() )
+       return SolveAnalytically();
+                        // In vacuum the elevation is solved directly, genetic algorithm is not needed
+
+     //------- Preparing threads and workers for parallel simulations --------------------------------
+
+     auto nrOfRuns = mSettings.GetRunsInGeneration();
+
+     if( 0 == nrOfRuns )
+     {
+       SIMFIRE_LOG( *this, LogLevel_t::kError, "CORE", "No runs to perform (number of runs is set to zero)" );
+       return false;
+     } // if
+
+     if( mSettings.GetEvalCache() && !mEvalCache )
+       mEvalCache = std::make_unique<CSimFireEvalCache>( mSettings );
+                        // Results are keyed also by settings, so the cache may live as long as the core
+
+     PrepareWorkers();
+     PrepareTelemetry();
+     PrepareTracer();
+
+     mMeasuredCosts.clear();
+
+     std::vector<std::string> vRunThreadIds( mWorkerPool->GetNumberOfWorkers() );
+     for( size_t thrdIdx = 0; thrdIdx < vRunThreadIds.size(); ++thrdIdx )
+       vRunThreadIds[thrdIdx] = FormatStr( "THRD_%02u", thrdIdx + 1 );
+                        // Identifiers belong to pool workers, runs are taken by whichever is free
+
+     ListOfRunDescriptors_t vRunParams( nrOfRuns, {} );
+                        // For each simulation there is a set of parameters. Simulations are divided
+                        // among workers according to the schedule: either into equal contiguous
+                        // bunches (static), taken one by one as workers get free (dynamic), or into
+                        // bunches of equal predicted cost, longest runs first (lpt). The latter two
+                        // balance the load when some shots (high arc) take many more ticks than others.
+
+     ListOfRunDescriptors_t vUncachedRunParams;
+     std::vector<size_t> vUncachedIdx;
+                        // Runs not found in the evaluation cache, which are really simulated, and their
+                        // indices in vRunParams
+
+     ListOfRunDescriptors_t vOrderedRunParams;
+     std::vector<double_t> vRunCosts;
+     std::vector<size_t> vRunOrder;
+     std::vector<size_t> vPartEnds;
+                        // Runs permuted by longest first schedule (vRunOrder[i] is the original index
+                        // of i-th run, vPartEnds ends of bunches of individual workers)
+
+     size_t chunk = UseBatchEngine() ?
+       std::max<size_t>( 4, nrOfRuns / ( 4 * mWorkerPool->GetNumberOfWorkers() ) ) : 1;
+                        // Batch engine needs several lanes at once to make use of SIMD instructions
+
+     double_t totalWallTime = 0.0;
+     double_t totalBarrierIdle = 0.0;
+
+     std::mutex deadlineMutex;
+     std::condition_variable deadlineSignal;
+     bool gaFinished = false;
+     std::thread deadlineWatchdog;
+     if( IsPositive( mSettings.GetDeadline() ) )
+       deadlineWatchdog = std::thread( [&, deadline = std::chrono::steady_clock::now() +
+         std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+           std::chrono::duration<double_t>( mSettings.GetDeadline() ) )]()
+       {                // Runs in flight are cancelled when the time is up, so the answer (the best run
+                        // so far) comes in bounded time, not after the whole generation
+         std::unique_lock lock( deadlineMutex );
+         if( !deadlineSignal.wait_until( lock, deadline, [&] { return gaFinished; } ) )
+         {
+           mDeadlinePassed.store( true );
+           mCancelRuns.store( true );
+         } // if
+       } );
+
      //------- Main GA loop ------------------------------------------------------------------------------
 
-     bool gaContinue = true;
+     bool gaContinue = !mSettings.GetSteadyState();
      GenerateInitialGeneration( vRunParams );
 
      size_t actGeneration = 0;
+     if( mSettings.GetSteadyState() )
+       actGeneration = ( RunSteadyState( vRunParams, vRunThreadIds ) - 1 ) / nrOfRuns;
+                        // No generations, number of simulated runs is expressed in them for the overview
+
 		 double_t avgDist = 0.0;
      double_t minDist = 1e99;
      double_t maxDist = 0.0;
@@ -120,44 +386,119 @@ namespace SimFire
      uint32_t overShots = 0;
      uint32_t underShots = 0;
 
-     do
+     uint32_t cancelledShots = 0;
+     uint32_t failedShots = 0;
+
+     while( gaContinue )
      {
-       for( size_t thrdIdx = 0; thrdIdx < nThreads; ++thrdIdx )
-       {
-         WriteLogMessage( "CORE",
-           FormatStr( "Creating thread %s to process runs #%zu to #%zu",
-             vRunThreadIds[thrdIdx], firstItem, lastItem - 1 ) );
+       ResetCancelRuns();
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Queueing %zu runs (%s schedule)",
+         vRunParams.size(), CSimFireWorkerPool::GetStrValue( mSettings.GetSchedule() ) );
+
+       ListOfRunDescriptors_t * simulatedRunParams = &vRunParams;
+       if( mEvalCache )
+       {                // Runs found in the cache get their results at once, only the rest is simulated
+         vUncachedRunParams.clear();
+         vUncachedIdx.clear();
+         for( size_t runIdx = 0; runIdx < vRunParams.size(); ++runIdx )
+         {
+           if( mEvalCache->Lookup( vRunParams[runIdx] ) )
+             continue;
+           vUncachedIdx.push_back( runIdx );
+           vUncachedRunParams.push_back( std::move( vRunParams[runIdx] ) );
+         } // for
+         simulatedRunParams = &vUncachedRunParams;
+       } // if
+       auto & vSimulated = *simulatedRunParams;
 
-         vRunFutures[thrdIdx] = std::async( std::launch::async, [=] {
-           RunBunch( vRunParamsPerThreadBunch[thrdIdx].first, vRunParamsPerThreadBunch[thrdIdx].second, 
-                     vRunThreadIds[thrdIdx] );
+       CSimFireWorkerPool::JobStats_t jobStats;
+       if( ScheduleType_t::kLongestFirst == mSettings.GetSchedule() )
+       {
+         PredictRunCosts( vSimulated, vRunCosts );
+         CSimFireWorkerPool::PartitionLongestFirst( vRunCosts, mWorkerPool->GetNumberOfWorkers(), vRunOrder, vPartEnds );
+
+         vOrderedRunParams.clear();
+         for( size_t runIdx : vRunOrder )
+           vOrderedRunParams.push_back( std::move( vSimulated[runIdx] ) );
+
+         jobStats = mWorkerPool->ForEachPart( vPartEnds,
+           [&]( size_t first, size_t last, uint32_t workerIdx )
+           {
+             RunBunch( vOrderedRunParams.begin() + first, vOrderedRunParams.begin() + last,
+               vRunThreadIds[workerIdx], workerIdx );
            } );
+                        // Returns after all simulation tasks are completed
 
-         firstItem = lastItem;
+         for( size_t orderIdx = 0; orderIdx < vRunOrder.size(); ++orderIdx )
+           vSimulated[vRunOrder[orderIdx]] = std::move( vOrderedRunParams[orderIdx] );
+                        // Back to the original order, the GA does not depend on the schedule
 
-       } // for
+         StoreRunCosts( vSimulated );
+       } // if
+       else
+       {
+         jobStats = mWorkerPool->ForEachRange( vSimulated.size(), mSettings.GetSchedule(), chunk,
+           [&]( size_t first, size_t last, uint32_t workerIdx )
+           {
+             RunBunch( vSimulated.begin() + first, vSimulated.begin() + last, vRunThreadIds[workerIdx], workerIdx );
+           } );
+                        // Returns after all simulation tasks are completed
+       } // else
 
-       for( auto & task : vRunFutures )
-       {                // Wait for all simulation tasks to complete
-         task.wait();
-       } // for
+       if( mTracer )
+       {                // The main thread waits for the whole job, workers wait at the barrier after their last bunch
+         int64_t jobEnd = mTracer->ToTracerTime( jobStats.end );
+         mTracer->AddSpan( 0, "Generation", "ga", jobEnd - (int64_t)( 1e9 * jobStats.wallTime ), jobEnd,
+           FormatStr( "\"generation\":%zu,\"runs\":%zu", actGeneration, vSimulated.size() ) );
+         for( uint32_t workerIdx = 0; workerIdx < jobStats.workerIdle.size(); ++workerIdx )
+           if( 0.0 < jobStats.workerIdle[workerIdx] )
+             mTracer->AddSpan( workerIdx + 1, "Barrier", "barrier",
+               jobEnd - (int64_t)( 1e9 * jobStats.workerIdle[workerIdx] ), jobEnd );
+       } // if
 
-       std::map<double_t, CSimFireSingleRunParams *> simpleDistanceSortedMiss;
-       for( auto & item : vRunParams )
-       {
-				 simpleDistanceSortedMiss[item.mVelocityZCoef] = &item;
-       }
+       uint64_t simulatedTicks = 0;
+       if( mTelemetry )
+         for( auto & item : vSimulated )
+           simulatedTicks += item.mSteps;
+                        // Runs taken from the cache are not simulated, so their ticks do not count
 
-			 for( auto & item : simpleDistanceSortedMiss )
+       if( mEvalCache )
        {
-         WriteLogMessage( "CORE",
-           FormatStr( "%s: %s %s ended with code %s in t = %.2f s",
-             item.second->mReturnCode != CSimFireSingleRunParams::SimResCode_t::kEndedCollision ? "MISS" : "HIT",
-             item.second->mRunIdentifier,
+         for( size_t uncachedIdx = 0; uncachedIdx < vUncachedIdx.size(); ++uncachedIdx )
+         {
+           mEvalCache->Store( vUncachedRunParams[uncachedIdx] );
+           vRunParams[vUncachedIdx[uncachedIdx]] = std::move( vUncachedRunParams[uncachedIdx] );
+         } // for
+         SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Evaluation cache: %zu of %zu runs taken from the cache",
+           vRunParams.size() - vUncachedIdx.size(), vRunParams.size() );
+       } // if
+
+       totalWallTime += jobStats.wallTime;
+       totalBarrierIdle += jobStats.barrierIdle;
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Generation simulated in %.3f ms, workers idle at the barrier "
+         "for %.3f ms (%.1f %% of their time)", 1000.0 * jobStats.wallTime, 1000.0 * jobStats.barrierIdle,
+         100.0 * jobStats.barrierIdle / std::max( gAlmostZero, jobStats.wallTime * mWorkerPool->GetNumberOfWorkers() ) );
+
+       if( IsLogEnabled( LogLevel_t::kDebug ) )
+       {                // Listing of all runs of the generation is sorted only if it is logged
+         std::map<double_t, CSimFireSingleRunParams *> simpleDistanceSortedMiss;
+         for( auto & item : vRunParams )
+           simpleDistanceSortedMiss[item.mVelocityZCoef] = &item;
+
+         for( auto & item : simpleDistanceSortedMiss )
+           SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "%s: %s %s ended with code %s in t = %.2f s, %s",
+             GetRunOutcome( *item.second ),
+             item.second->GetRunIdentifier(),
              item.second->GetRunDesc(),
              CSimFireSingleRunParams::GetStrValue( item.second->mReturnCode ),
-             item.second->mSimTime ) );
-       }
+             item.second->mSimTime,
+             item.second->GetStepsDesc() );
+       } // if
+
+       bool improved = false;
+       for( auto & item : vRunParams )
+         improved = UpdateBestRun( item ) || improved;
+       mStagnantGenerations = improved ? 0 : mStagnantGenerations + 1;
 
        gaContinue = ContinueNextGAIteration( vRunParams, actGeneration );
 
@@ -170,9 +511,20 @@ namespace SimFire
        farShots = 0;
        overShots = 0;
        underShots = 0;
+       cancelledShots = 0;
+       failedShots = 0;
 
        for( auto & item : vRunParams )
        {
+         if( !IsRunCompleted( item ) )
+         {              // Cancelled (or not started) and failed runs keep the initial distance, they are
+                        // not misses
+           if( CSimFireSingleRunParams::SimResCode_t::kError == item.mReturnCode )
+             ++failedShots;
+           else
+             ++cancelledShots;
+           continue;
+         } // if
 
          auto dist = std::sqrt( item.mMinDTgtSq );
          if( dist < minDist )
@@ -199,18 +551,30 @@ namespace SimFire
 				 } // else
 
 			 } // for
-       avgDist /= (double_t)vRunParams.size();
-
-       WriteLogMessage( "CORE", FormatStr( "Minimal distance: %f m", minDist ) );
-       WriteLogMessage( "CORE", FormatStr( "Average distance: %f m", avgDist ) );
-			 WriteLogMessage( "CORE", FormatStr( "Maximal distance: %f m", maxDist ) );
-
-			 WriteLogMessage( "CORE", FormatStr( "Rising shots: %u", risingShots ) );
-       WriteLogMessage( "CORE", FormatStr( " -> Under shots: %u", underShots ) );
-			 WriteLogMessage( "CORE", FormatStr( " -> Over shots: %u", overShots ) );
-			 WriteLogMessage( "CORE", FormatStr( "Falling shots: %u", fallingShots ) );
-       WriteLogMessage( "CORE", FormatStr( " -> Near shots: %u", nearShots ) );
-			 WriteLogMessage( "CORE", FormatStr( " -> Far shots: %u", farShots ) );
+       avgDist /= (double_t)std::max<size_t>( 1, vRunParams.size() - cancelledShots - failedShots );
+
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Minimal distance: %f m", minDist );
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Average distance: %f m", avgDist );
+			 SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Maximal distance: %f m", maxDist );
+
+			 SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Rising shots: %u", risingShots );
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", " -> Under shots: %u", underShots );
+			 SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", " -> Over shots: %u", overShots );
+			 SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Falling shots: %u", fallingShots );
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", " -> Near shots: %u", nearShots );
+			 SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", " -> Far shots: %u", farShots );
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Cancelled shots: %u", cancelledShots );
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "Failed shots: %u", failedShots );
+
+       if( mTelemetry )
+       {
+         CSimFireTelemetry::Record_t record{ actGeneration, jobStats.wallTime, vRunParams.size(),
+           vRunParams.size() - vSimulated.size(), simulatedTicks, 0, 0, 0, std::numeric_limits<double_t>::max(),
+           0.0, 0.0, jobStats.workerIdle };
+         for( auto & item : vRunParams )
+           AddRunToTelemetry( record, item );
+         WriteTelemetry( record, vRunParams );
+       } // if
 
        if( gaContinue )
        {
@@ -218,12 +582,24 @@ namespace SimFire
          ++actGeneration;
 			 } // if
 
-     } while( gaContinue );
+     } // while
+
+     {
+       std::lock_guard lock( deadlineMutex );
+       gaFinished = true;
+     }
+     deadlineSignal.notify_all();
+     if( deadlineWatchdog.joinable() )
+       deadlineWatchdog.join();
+
+     mTelemetry.reset();// Closes the file, it is complete
+     FinishTracer();
 
      //------- Results overview --------------------------------------------------------------------------
 
-     WriteLogMessage( "CORE", "\n\n****************************************\nSimulation finished,"
-                              "results overview\n****************************************\n" );
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE",
+       "\n\n****************************************\nSimulation finished,"
+       "results overview\n****************************************\n" );
 
      size_t nHits = 0;
      for( auto & item : vRunParams )
@@ -231,37 +607,171 @@ namespace SimFire
        if( item.mReturnCode == CSimFireSingleRunParams::SimResCode_t::kEndedCollision )
        {
          ++nHits;
-         WriteLogMessage( "CORE",
-           FormatStr( "Run [%f, %f, %f] hits the target after %.2f s",
-             item.mVelocityXCoef, item.mVelocityYCoef, item.mVelocityZCoef,
-             item.mSimTime  ) );
+         SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE",
+           "Run [%f, %f, %f] hits the target after %.2f s at [%.3f, %.3f, %.3f]",
+           item.mVelocityXCoef, item.mVelocityYCoef, item.mVelocityZCoef,
+           item.mImpactTime, item.mContactX, item.mContactY, item.mContactZ );
        } // if
      } // for
 
      if( 0 == nHits )
      {
-       WriteLogMessage( "CORE", FormatStr( "After %zu generations no hits were achieved.",
-         actGeneration + 1 ) );
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "After %zu generations no hits were achieved.",
+         actGeneration + 1 );
      } // if
      else
      {
-       WriteLogMessage( "CORE", FormatStr( "After %zu generations %zu hits were achieved.",
-         actGeneration + 1, nHits ) );
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "After %zu generations %zu hits were achieved.",
+         actGeneration + 1, nHits );
      } // else
 
-     WriteLogMessage( "CORE", "\n\n****************************************\n" );
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "Genetic algorithm stopped: %s", GetStrValue( mStopReason ) );
+
+     if( CSimFireSingleRunParams::SimResCode_t::kNotStarted == mBestRun.mReturnCode )
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "No run was completed, there is no firing solution." );
+     else
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "Best firing solution: %s aim [%f, %f, %f], %s",
+         mBestRun.GetRunIdentifier(), mBestRun.mVelocityXCoef, mBestRun.mVelocityYCoef, mBestRun.mVelocityZCoef,
+         ( CSimFireSingleRunParams::SimResCode_t::kEndedCollision == mBestRun.mReturnCode ) ?
+           FormatStr( "hit after %.2f s", mBestRun.mImpactTime ) :
+           FormatStr( "miss distance %f m", std::sqrt( mBestRun.mMinDTgtSq ) ) );
+
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "\n\n****************************************\n" );
+
+     std::string idleTimes;
+     for( uint32_t workerIdx = 0; workerIdx < mWorkerPool->GetNumberOfWorkers(); ++workerIdx )
+       idleTimes += FormatStr( "%s%.3f", idleTimes.empty() ? "" : ", ", mWorkerPool->GetIdleTime( workerIdx ) );
+
+     if( !mSettings.GetSteadyState() )
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE",
+         "Schedule %s: simulation of generations took %.3f ms, workers idle at "
+         "barriers for %.3f ms (%.1f %% of their time)", CSimFireWorkerPool::GetStrValue( mSettings.GetSchedule() ),
+         1000.0 * totalWallTime, 1000.0 * totalBarrierIdle,
+         100.0 * totalBarrierIdle / std::max( gAlmostZero, totalWallTime * mWorkerPool->GetNumberOfWorkers() ) );
+
+     if( mEvalCache )
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "Evaluation cache: %zu hits, %zu stored results",
+         (size_t)mEvalCache->GetHits(), mEvalCache->GetSize() );
+
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "Worker pool: %u threads, %zu tasks, queue wait %.3f ms on average "
+       "(max %.3f ms), idle time of workers [%s] s", mWorkerPool->GetNumberOfWorkers(),
+       (size_t)mWorkerPool->GetTasksDone(),
+       1000.0 * mWorkerPool->GetQueueWaitTime() / std::max<uint64_t>( 1, mWorkerPool->GetTasksDone() ),
+       1000.0 * mWorkerPool->GetMaxQueueWaitTime(), idleTimes );
 
      return true;
 
-   } // CSimFireCore::Run
+   } // CSimFireCore::RunSimulation
 
    //-------------------------------------------------------------------------------------------------
 
-   void CSimFireCore::WriteLogMessage( const std::string & id, const std::string & mssg )
+   bool CSimFireCore::SolveAnalytically()
    {
+     static const CSimFireSingleRunParams::RunLabel_t arcLabels[] =
+       { CSimFireSingleRunParams::RunLabel_t::kLowArc, CSimFireSingleRunParams::RunLabel_t::kHighArc };
+
+     double_t distX = mSettings.GetTgtX() - mSettings.GetGunX();
+     double_t distY = mSettings.GetTgtY() - mSettings.GetGunY();
+     double_t range = std::sqrt( distX * distX + distY * distY );
+
+     std::array<double_t, 2> tanElevation{ 0.0, 0.0 };
+     uint32_t nrSolutions = VacuumElevations(
+       Point_t{ mSettings.GetGunX(), mSettings.GetGunY(), mSettings.GetGunZ() },
+       Point_t{ mSettings.GetTgtX(), mSettings.GetTgtY(), mSettings.GetTgtZ() },
+       mSettings.GetVelocity(), mSettings.GetG(), tanElevation );
+
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE",
+       "\n\n****************************************\nAnalytic solution in vacuum,"
+       " results overview\n****************************************\n" );
+
+     if( 0 == nrSolutions )
+     {
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE",
+         "Target is out of reach of given muzzle velocity (or straight above the "
+         "shooter), no elevation hits it." );
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "\n\n****************************************\n" );
+       return true;
+     } // if
+
+     CSimFireSingleRun runWorker( mSettings, nullptr );
+     CSimFireSingleRun checkWorker( mSettings, nullptr );
+     checkWorker.SetIntegrator( IntegratorType_t::kEuler );
+                        // Solutions are evaluated in closed form, cross-check runs the same shots
+                        // through the main loop with basic time discretization.
+
+     size_t nHits = 0;
+     for( uint32_t i = 0; i < nrSolutions; ++i )
+     {
+       CSimFireSingleRunParams item;
+       item.Reset();
+       item.mRunLabel = arcLabels[i];
+       item.mThreadLabel = CSimFireSingleRunParams::ThreadLabel_t::kCore;
+       item.mVelocityXCoef = distX;
+       item.mVelocityYCoef = distY;
+       item.mVelocityZCoef = range * tanElevation[i];
+                        // Same representation as in genetic algorithm, X and Y are constant and
+                        // elevation is given by Z coefficient.
+
+       runWorker.Run( item );
+       UpdateBestRun( item );
+
+       SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "%s: elevation %.6f deg, %s ended with code %s in t = %.4f s",
+         item.GetRunIdentifier(), std::atan( tanElevation[i] ) * 180.0 / gPI, item.GetRunDesc(),
+         CSimFireSingleRunParams::GetStrValue( item.mReturnCode ), item.mSimTime );
+
+       if( item.mReturnCode == CSimFireSingleRunParams::SimResCode_t::kEndedCollision )
+       {
+         ++nHits;
+         SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE",
+           "Run [%f, %f, %f] hits the target after %.4f s at [%.3f, %.3f, %.3f]",
+           item.mVelocityXCoef, item.mVelocityYCoef, item.mVelocityZCoef,
+           item.mImpactTime, item.mContactX, item.mContactY, item.mContactZ );
+       } // if
+
+       if( mSettings.GetCrossCheck() )
+       {
+         CSimFireSingleRunParams check( item );
+         check.Reset( false );
+         checkWorker.Run( check );
+
+         SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "%s: cross-check by %s ended with code %s (%s), "
+                                             "impact time difference %.6f s, closest approach difference %.6f m",
+           item.GetRunIdentifier(), SimFire::GetStrValue( IntegratorType_t::kEuler ),
+           CSimFireSingleRunParams::GetStrValue( check.mReturnCode ),
+           ( check.mReturnCode == item.mReturnCode ) ? "agrees" : "DIFFERS",
+           check.mImpactTime - item.mImpactTime,
+           std::sqrt( check.mMinDTgtSq ) - std::sqrt( item.mMinDTgtSq ) );
+       } // if
+     } // for
+
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "%zu of %u analytic solutions hit the target.", nHits, nrSolutions );
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "\n\n****************************************\n" );
+
+     return true;
+
+   } // CSimFireCore::SolveAnalytically
+
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::WriteLogMessage( LogLevel_t level, const std::string & id, const std::string & mssg )
+   {
+     if( !IsLogEnabled( level ) )
+       return;          // Callers which format the message use SIMFIRE_LOG, so this is rare
+
+     std::string warning;
+     if( LogLevel_t::kWarning <= level )
+       warning = FormatStr( "%s: %s", CSimFireLogger::GetStrValue( level ), mssg );
+     const std::string & text = warning.empty() ? mssg : warning;
+
+     if( mLogger )
+     {
+       mLogger->Write( id, text );
+       return;          // Written by the logger thread, the caller never waits for the console
+     } // if
+
      std::lock_guard lock( mLogMutex );
 
-     std::cout << "[" << id << "]   " << mssg << std::endl;
+     std::cout << "[" << id << "]   " << text << std::endl;
 
    } // CSimFireCore::WriteLogMessage
 
@@ -270,33 +780,120 @@ namespace SimFire
    void CSimFireCore::RunBunch(
      ListOfRunDescriptors_t::iterator runParamsBegin,
      ListOfRunDescriptors_t::iterator runParamsEnd,
-     const std::string & threadId )
+     const std::string & threadId,
+     uint32_t workerIdx )
    {
+     int64_t bunchStart = mTracer ? mTracer->Now() : 0;
 
      for( auto it = runParamsBegin; it != runParamsEnd; ++it )
        it->mReturnCode = CSimFireSingleRunParams::SimResCode_t::kNotStarted;
 
-     CSimFireSingleRun runWorker( mSettings, 
-       BIND_SINGLE_RUN_LOG_CALLBACK( this, CSimFireCore::WriteLogMessage ) );
+     if( 1 < std::distance( runParamsBegin, runParamsEnd ) && IsLogEnabled( LogLevel_t::kDebug ) )
+     {                  // List of runs is built only if it is logged. Bunches of a single run (dynamic
+                        // schedule, steady state) are not listed, the run itself is logged at its end.
+       size_t nr = 0;
+       std::string runList;
+       for( auto it = runParamsBegin; it != runParamsEnd; ++it, ++nr )
+       {
+         if( !runList.empty() )
+           runList += ", ";
+         runList += it->GetRunIdentifier();
+       }
+
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, threadId, "Starting a batch of %zu runs: %s",  nr, runList );
+     } // if
 
-     unsigned nr = 0;
-     std::string runList;
-     for( auto it = runParamsBegin; it != runParamsEnd; ++it, ++nr )
+     for( auto it = runParamsBegin; it != runParamsEnd; ++it )
+     {                  // Thread identifier is built from these only when needed
+       it->mThreadLabel = CSimFireSingleRunParams::ThreadLabel_t::kWorker;
+       it->mThreadNr = (uint16_t)( workerIdx + 1 );
+     } // for
+
+     if( UseBatchEngine() && runParamsBegin != runParamsEnd )
+     {                  // All runs of the bunch are simulated at once in lockstep. Batch engine does
+                        // not support logging of individual ticks, other integrators, continuous
+                        // collision detection nor sub-tick closest approach, single runs are used for them.
+       auto & batchWorker = mBatchWorkers[workerIdx];
+       if( !batchWorker )
+         batchWorker = std::make_unique<CSimFireBatchRun>( mSettings,
+           BIND_SINGLE_RUN_LOG_CALLBACK( this, CSimFireCore::WriteLogMessage ) );
+       batchWorker->SetCancelToken( &mCancelRuns );
+
+       batchWorker->Run( std::span<CSimFireSingleRunParams>( runParamsBegin, runParamsEnd ) );
+     } // if
+     else
      {
-       if( !runList.empty() )
-         runList += ", ";
-       runList += it->mRunIdentifier;
-     }
+       auto & runWorker = *mRunWorkers[workerIdx];
+                        // Each pool worker has its own run worker, registry and buffers stay warm
 
-     WriteLogMessage( threadId, FormatStr( "Starting a batch of %zu runs: %s",  nr, runList ));
+       for( auto it = runParamsBegin; it != runParamsEnd; ++it )
+       {
+         int64_t runStart = mTracer ? mTracer->Now() : 0;
+         runWorker.Run( *it );
+         if( mTracer )
+           mTracer->AddSpan( workerIdx + 1, "Run", "run", runStart, mTracer->Now(),
+             FormatStr( "\"run\":\"%s\",\"thread\":\"%s\",\"ticks\":%llu,\"result\":\"%s\"",
+               it->GetRunIdentifier(), threadId, it->mSteps,
+               CSimFireSingleRunParams::GetStrValue( it->mReturnCode ) ) );
+                        // Arguments are formatted after the end of the span is taken
+       } // for
+     } // else
 
-     for( auto it = runParamsBegin; it != runParamsEnd; ++it )
+     if( mTracer )
+       mTracer->AddSpan( workerIdx + 1, "RunBunch", "worker", bunchStart, mTracer->Now(),
+         FormatStr( "\"runs\":%zu,\"engine\":\"%s\"", (size_t)std::distance( runParamsBegin, runParamsEnd ),
+           UseBatchEngine() ? "batch" : "single" ) );
+
+   } // CSimFireCore::RunBunch
+
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::PredictRunCosts( const ListOfRunDescriptors_t & runParams, std::vector<double_t> & costs ) const
+   {
+     costs.resize( runParams.size() );
+
+     for( size_t runIdx = 0; runIdx < runParams.size(); ++runIdx )
      {
-       it->mThreadIdentifier = threadId;
-       runWorker.Run( *it );
+       auto & item = runParams[runIdx];
+       if( mMeasuredCosts.empty() )
+       {                // Initial generation, nothing measured yet
+         costs[runIdx] = CSimFireSingleRun::EstimateFlightTime( mSettings, item ) /
+           std::max( gAlmostZero, mSettings.GetDt() );
+         continue;
+       } // if
+
+       double_t elevation = std::atan2( item.mVelocityZCoef, std::hypot( item.mVelocityXCoef, item.mVelocityYCoef ) );
+       auto next = std::lower_bound( mMeasuredCosts.begin(), mMeasuredCosts.end(),
+         std::make_pair( elevation, 0.0 ) );
+       if( next == mMeasuredCosts.end() ||
+         ( next != mMeasuredCosts.begin() && elevation - std::prev( next )->first < next->first - elevation ) )
+         --next;
+       costs[runIdx] = next->second;
      } // for
 
-   } // CSimFireCore::RunBunch
+   } // CSimFireCore::PredictRunCosts
+
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::StoreRunCosts( const ListOfRunDescriptors_t & runParams )
+   {
+     mMeasuredCosts.clear();
+     for( auto & item : runParams )
+       mMeasuredCosts.emplace_back(
+         std::atan2( item.mVelocityZCoef, std::hypot( item.mVelocityXCoef, item.mVelocityYCoef ) ),
+         (double_t)item.mSteps );
+     std::sort( mMeasuredCosts.begin(), mMeasuredCosts.end() );
+
+   } // CSimFireCore::StoreRunCosts
+
+   //-------------------------------------------------------------------------------------------------
+
+   bool CSimFireCore::UseBatchEngine() const
+   {
+     return mSettings.GetBatchEngine() && IntegratorType_t::kEuler == mSettings.GetIntegrator() &&
+       !mSettings.GetContinuousCollisions() && !mSettings.GetSubTickApproach() &&
+       !IsPositive( mSettings.GetLogInterval() );
+   } // CSimFireCore::UseBatchEngine
 
    //-------------------------------------------------------------------------------------------------
 
@@ -306,7 +903,7 @@ namespace SimFire
      uint32_t runNr = 0;
      for( auto & item : runParams )
      {
-       item.mRunIdentifier = FormatStr( "RUN_%02u", ++runNr );
+       item.mRunNr = ++runNr;
        item.mMinDTgtSq = std::numeric_limits<double_t>::max();
        item.mMinTime = 0.0;
        item.mNearHalfPlane = false;
@@ -314,8 +911,8 @@ namespace SimFire
        item.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kNotStarted;
      } // for
 
-     size_t fillingNewItem = 0;
-     Hallucinate( runParams, fillingNewItem, 0.25 );
+     if( !runParams.empty() )
+       BreedChildren( BreedingOp_t{ kRandom, 0, 1, 0, 0, 0, kZRatioRnd }, runParams, RandomStream( 0, false ) );
                         // Initial velocity direction coefficients are generated as random values 
                         // around the LOS vector to the target in Z axis, X and Y axis are constant. 
                         // This only  places the unknown variable to the Z axis (angle) - the entire 
@@ -329,349 +926,640 @@ namespace SimFire
 
    //-------------------------------------------------------------------------------------------------
 
-   void CSimFireCore::Spawn(
-     std::map<double_t, CSimFireSingleRunParams> & queue,
-     ListOfRunDescriptors_t & runParams,
-     size_t & fillingNewItem,
-     size_t spawners,
-     double_t fineTuneCoef )
+   size_t CSimFireCore::RunSteadyState( ListOfRunDescriptors_t & runParams, const std::vector<std::string> & threadIds )
    {
-		 auto it = queue.begin();
-     while( 0 < spawners && it != queue.end() )
-     {
-			 auto &item = it->second;
-
-       double_t coef1 = 1.0;
-			 double_t coef2 = 1.0;
-
-       if( item.mRaising )
+     size_t populationSize = runParams.size();
+     size_t maxRuns = populationSize * ( (size_t)mSettings.GetMaxGenerations() + 1 );
+                        // At most the same number of runs as all generations would simulate
+
+     std::mutex gaMutex;// Guards all the state below
+     ListOfRunDescriptors_t population;
+     std::deque<CSimFireSingleRunParams> waiting( runParams.begin(), runParams.end() );
+                        // Runs waiting for a free worker, the initial ones first, then the offspring
+     ListOfRunDescriptors_t offspring;
+     size_t dispatched = 0;
+     size_t finished = 0;
+     size_t breedingNr = 0;
+     size_t runNr = populationSize;
+     size_t lastImprovement = 0;
+
+     CSimFireTelemetry::Record_t window{ 0, 0.0, 0, 0, 0, 0, 0, 0, std::numeric_limits<double_t>::max(), 0.0, 0.0, {} };
+     auto windowStart = std::chrono::steady_clock::now();
+     std::vector<double_t> windowIdleStart( mWorkerPool->GetNumberOfWorkers(), 0.0 );
+                        // There is no barrier, telemetry takes each population size of finished runs
+                        // as a generation and idle time of workers as time spent waiting for a run
+
+     auto writeWindow = [&]()
+     {                  // Telemetry of the finished runs since the last record, called with gaMutex locked
+       auto now = std::chrono::steady_clock::now();
+       window.wallTime = std::chrono::duration<double_t>( now - windowStart ).count();
+       window.workerIdle.resize( windowIdleStart.size() );
+       for( uint32_t workerIdx = 0; workerIdx < windowIdleStart.size(); ++workerIdx )
        {
-         if( item.mBelow )
-         {
-           coef1 += fineTuneCoef;
-					 coef2 += 2 * fineTuneCoef;
-         }
+         double_t idle = mWorkerPool->GetIdleTime( workerIdx );
+         window.workerIdle[workerIdx] = idle - windowIdleStart[workerIdx];
+         windowIdleStart[workerIdx] = idle;
+       } // for
+       WriteTelemetry( window, population );
+
+       ++window.generation;
+       window.runs = 0;
+       window.cacheHits = 0;
+       window.ticks = 0;
+       window.hits = 0;
+       window.cancelled = 0;
+       window.errors = 0;
+       window.bestMiss = std::numeric_limits<double_t>::max();
+       window.avgMiss = 0.0;
+       windowStart = now;
+     };
+
+     auto acceptRun = [&]( CSimFireSingleRunParams & item, bool cached )
+     {                  // Result of the run enters the population, called with gaMutex locked
+       ++finished;
+
+       if( mTelemetry )
+       {
+         ++window.runs;
+         if( cached )
+           ++window.cacheHits;
          else
-         {
-           coef1 -= fineTuneCoef;
-           coef2 -= 2 * fineTuneCoef;
-         }
+           window.ticks += item.mSteps;
+         AddRunToTelemetry( window, item );
        } // if
-       else
+
+       SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "%s: %s %s ended with code %s in t = %.2f s, %s",
+         GetRunOutcome( item ),
+         item.GetRunIdentifier(),
+         item.GetRunDesc(),
+         CSimFireSingleRunParams::GetStrValue( item.mReturnCode ),
+         item.mSimTime,
+         item.GetStepsDesc() );
+
+       if( UpdateBestRun( item ) )
+         lastImprovement = finished;
+
+       population.push_back( std::move( item ) );
+       if( population.size() > populationSize )
+         population.erase( std::max_element( population.begin(), population.end(),
+           []( const CSimFireSingleRunParams & a, const CSimFireSingleRunParams & b )
+           { return a.mMinDTgtSq < b.mMinDTgtSq; } ) );
+                        // The most distant run leaves the population
+
+       if( mTelemetry && populationSize == window.runs )
+         writeWindow();
+
+       if( StopReason_t::kNone != mStopReason )
+         return;
+       if( CSimFireSingleRunParams::SimResCode_t::kEndedCollision == mBestRun.mReturnCode )
+         mStopReason = StopReason_t::kHit;
+                        // A hit is always the best run
+       else if( mDeadlinePassed.load() )
+         mStopReason = StopReason_t::kDeadline;
+       else if( 0 < mSettings.GetStagnationLimit() &&
+                finished - lastImprovement >= (size_t)mSettings.GetStagnationLimit() * populationSize )
+         mStopReason = StopReason_t::kStagnation;
+                        // Generation is expressed as population size of simulated runs
+       else if( IsPositive( mSettings.GetConvergenceTolerance() ) && population.size() == populationSize &&
+                SurvivorsSpread( population ) < mSettings.GetConvergenceTolerance() )
+         mStopReason = StopReason_t::kConverged;
+     };
+
+     std::function<void()> dispatchNext;
+     dispatchNext = [&]()
+     {                  // Gives the next run to the pool, called with gaMutex locked. Runs found in
+                        // the evaluation cache are accepted at once and the next one is taken.
+       while( StopReason_t::kNone == mStopReason && !mDeadlinePassed.load() && dispatched < maxRuns )
        {
-         if( item.mNearHalfPlane )
+         if( waiting.empty() )
          {
-           coef1 += fineTuneCoef;
-           coef2 += 2 * fineTuneCoef;
-         }
-         else
+           BreedOffspring( population, breedingNr++,
+             kFineTuneCoef * std::pow( kFineTuneDecay, (double_t)( finished / populationSize ) ), offspring );
+                        // Fine tuning decays after each population size of simulated runs
+           for( auto & item : offspring )
+           {
+             item.mRunNr = (uint32_t)++runNr;
+             waiting.push_back( item );
+           } // for
+         } // if
+
+         ListOfRunDescriptors_t run( 1, waiting.front() );
+         waiting.pop_front();
+         ++dispatched;
+
+         if( mEvalCache && mEvalCache->Lookup( run.front() ) )
          {
-           coef1 -= fineTuneCoef;
-           coef2 -= 2 * fineTuneCoef;
-         }
-       } // else
-
-       std::string tmpOut = FormatStr( "SPAWNING\n\n%s", item.GetRunDesc() );
+           acceptRun( run.front(), true );
+           continue;
+         } // if
 
-       if( fillingNewItem >= runParams.size() )
+         mWorkerPool->Submit( [&, run]( uint32_t workerIdx ) mutable
+         {
+           RunBunch( run.begin(), run.end(), threadIds[workerIdx], workerIdx );
+
+           std::lock_guard lock( gaMutex );
+           if( mEvalCache )
+             mEvalCache->Store( run.front() );
+           acceptRun( run.front(), false );
+           dispatchNext();
+                        // The worker which is just being freed gets a new run
+         } );
          return;
-       auto & newItem0 = runParams[fillingNewItem++];
-       newItem0.Reset();
-       newItem0.mVelocityXCoef = item.mVelocityXCoef;
-       newItem0.mVelocityYCoef = item.mVelocityYCoef;
-       newItem0.mVelocityZCoef = item.mVelocityZCoef;
+       } // while
+     };
 
-       if( fillingNewItem >= runParams.size() )
-         return;
-       auto & newItem1 = runParams[fillingNewItem++];
-       newItem1.Reset();
-       newItem1.mVelocityXCoef = item.mVelocityXCoef;
-       newItem1.mVelocityYCoef = item.mVelocityYCoef;
-       newItem1.mVelocityZCoef = item.mVelocityZCoef * coef1;
+     ResetCancelRuns();
+                        // The first hit cancels runs in flight if the user needs only one solution
 
-       if( fillingNewItem >= runParams.size() )
-         return;
-       auto & newItem2 = runParams[fillingNewItem++];
-       newItem2.Reset();
-       newItem2.mVelocityXCoef = item.mVelocityXCoef;
-       newItem2.mVelocityYCoef = item.mVelocityYCoef;
-       newItem2.mVelocityZCoef = item.mVelocityZCoef * coef2;
+     auto start = std::chrono::steady_clock::now();
+     {
+       std::lock_guard lock( gaMutex );
+       windowStart = start;
+       for( uint32_t workerIdx = 0; workerIdx < windowIdleStart.size(); ++workerIdx )
+         windowIdleStart[workerIdx] = mWorkerPool->GetIdleTime( workerIdx );
+       for( uint32_t workerIdx = 0; workerIdx < mWorkerPool->GetNumberOfWorkers(); ++workerIdx )
+         dispatchNext();
+     }
+     mWorkerPool->Wait();
+                        // Returns when the last run ends and no new one was dispatched
 
-       tmpOut += FormatStr( "\n----------------------------------\n[%f, %f, %f], [%f, %f, %f]\n\n",
-         newItem1.mVelocityXCoef, newItem1.mVelocityYCoef, newItem1.mVelocityZCoef,
-         newItem2.mVelocityXCoef, newItem2.mVelocityYCoef, newItem2.mVelocityZCoef );
-       WriteLogMessage( "CORE", tmpOut );
+     if( mTelemetry && 0 < window.runs )
+       writeWindow();   // The last incomplete window
 
-       ++it;
-       --spawners;
-		 } // while
+     SIMFIRE_LOG( *this, LogLevel_t::kInfo, "CORE", "Steady-state GA: %zu runs evaluated in %.3f ms, %zu breedings",
+       finished, 1000.0 * std::chrono::duration<double_t>( std::chrono::steady_clock::now() - start ).count(),
+       breedingNr );
 
-	 } // CSimFireCore::Spawn
+     if( StopReason_t::kNone == mStopReason )
+       mStopReason = mDeadlinePassed.load() ? StopReason_t::kDeadline : StopReason_t::kMaxGenerations;
+
+     runParams = std::move( population );
+     return finished;
+
+   } // CSimFireCore::RunSteadyState
 
    //-------------------------------------------------------------------------------------------------
 
-   void CSimFireCore::Recombine(
-     std::map<double_t, CSimFireSingleRunParams> & queue1,
-     std::map<double_t, CSimFireSingleRunParams> & queue2,
-     ListOfRunDescriptors_t & runParams,
-     size_t &fillingNewItem,
-     double_t incCoef,
-     double_t decCoef )
+   void CSimFireCore::BreedOffspring(
+     const ListOfRunDescriptors_t & population,
+     size_t breedingNr,
+     double_t fineTuneCoef,
+     ListOfRunDescriptors_t & offspring )
    {
-     auto nm = queue1.extract( queue1.begin() );
-     auto & nmItem = nm.mapped();
+     PartitionResults( population, AverageMissDistance( population ) );
 
-     auto fm = queue2.extract( queue2.begin() );
-     auto & fmItem = fm.mapped();
+     auto category = (MissCategory_t)( ( breedingNr / 3 ) % kMissCategories );
+                        // Category used by spawning and mutation, they take turns
 
-     std::string tmpOut = FormatStr( "RECOMBININING\n\n%s\n%s",
-       nmItem.GetRunDesc(), fmItem.GetRunDesc() );
+     BreedingOp_t op{ kRandom, 0, 0, 0, 0, 0, kZRatioRnd };
 
-     if( fillingNewItem >= runParams.size() )
-       return;
-     auto & newItem1 = runParams[fillingNewItem++];
-     newItem1.Reset();
-     newItem1.mVelocityXCoef = ( nmItem.mVelocityXCoef + fmItem.mVelocityXCoef ) * 0.5;
-     newItem1.mVelocityYCoef = ( nmItem.mVelocityYCoef + fmItem.mVelocityYCoef ) * 0.5;
-     newItem1.mVelocityZCoef = ( incCoef * nmItem.mVelocityZCoef + decCoef * fmItem.mVelocityZCoef ) /
-                               ( decCoef + incCoef );
-
-     if( fillingNewItem >= runParams.size() )
-       return;
-     auto & newItem2 = runParams[fillingNewItem++];
-     newItem2.Reset();
-     newItem2.mVelocityXCoef = ( nmItem.mVelocityXCoef + fmItem.mVelocityXCoef ) * 0.5;
-     newItem2.mVelocityYCoef = ( nmItem.mVelocityYCoef + fmItem.mVelocityYCoef ) * 0.5;
-     newItem2.mVelocityZCoef = ( decCoef * nmItem.mVelocityZCoef + incCoef * fmItem.mVelocityZCoef ) / 
-                               ( decCoef + incCoef );
-
-     if( fillingNewItem >= runParams.size() )
-       return;
-     auto & newItem3 = runParams[fillingNewItem++];
-     newItem3.Reset();
-     newItem3.mVelocityXCoef = ( nmItem.mVelocityXCoef + fmItem.mVelocityXCoef ) * 0.5;
-     newItem3.mVelocityYCoef = ( nmItem.mVelocityYCoef + fmItem.mVelocityYCoef ) * 0.5;
-     newItem3.mVelocityZCoef = ( nmItem.mVelocityZCoef + fmItem.mVelocityZCoef ) * 0.5;
+     for( size_t attempt = 0; attempt < 3 && 0 == op.nChildren; ++attempt )
+     {                  // Operators take turns, if the chosen one has no parents, the next one is tried
+       switch( ( breedingNr + attempt ) % 3 )
+       {
+         case 0:
+           if( 0 < CategorySize( kNearWhileFalling ) && 0 < CategorySize( kFarWhileFalling ) )
+             op = BreedingOp_t{ kRecombine, 0, 3, CategoryRecord( kNearWhileFalling, 0 ),
+               CategoryRecord( kFarWhileFalling, 0 ), 0, 0.0 };
+           else if( 0 < CategorySize( kOverWhileRaising ) && 0 < CategorySize( kUnderWhileRaising ) )
+             op = BreedingOp_t{ kRecombine, 0, 3, CategoryRecord( kOverWhileRaising, 0 ),
+               CategoryRecord( kUnderWhileRaising, 0 ), 0, 0.0 };
+           break;
+
+         case 1:
+           if( 0 < CategorySize( category ) )
+             op = BreedingOp_t{ kSpawn, 1, 2, CategoryRecord( category, 0 ), 0, 0, fineTuneCoef };
+                        // The clone of the parent is skipped, the parent is still in the population
+           break;
+
+         default:
+           if( 0 < CategorySize( category ) )
+             op = BreedingOp_t{ kMutate, 0, 1, CategoryRecord( category, 0 ), 0, 0, kMutationCoefs[category] };
+           break;
+       } // switch
+     } // for
 
+     if( 0 == op.nChildren )
+       op.nChildren = 1;// A random run if no operator applies
 
-     tmpOut += FormatStr( "\n----------------------------------\n[%f, %f, %f], [%f, %f, %f], [%f, %f, %f]\n\n",
-			 newItem1.mVelocityXCoef, newItem1.mVelocityYCoef, newItem1.mVelocityZCoef,
-       newItem2.mVelocityXCoef, newItem2.mVelocityYCoef, newItem2.mVelocityZCoef,
-       newItem3.mVelocityXCoef, newItem3.mVelocityYCoef, newItem3.mVelocityZCoef );
-		 WriteLogMessage( "CORE", tmpOut );
+     offspring.resize( op.nChildren );
+     BreedChildren( op, offspring, RandomStream( breedingNr, true ) );
 
-   }
+   } // CSimFireCore::BreedOffspring
 
    //-------------------------------------------------------------------------------------------------
 
-   void CSimFireCore::Mutate(
-     CSimFireSingleRunParams & item,
-     ListOfRunDescriptors_t & runParams,
-     size_t & fillingNewItem,
-     double_t coef ) 
+   uint64_t CSimFireCore::RandomStream( size_t generation, bool steadyState )
    {
-     if( fillingNewItem >= runParams.size() )
-       return;
-     auto & newItem = runParams[fillingNewItem++];
-     newItem.Reset();
-     newItem.mVelocityXCoef = item.mVelocityXCoef;
-     newItem.mVelocityYCoef = item.mVelocityYCoef;
-     newItem.mVelocityZCoef = item.mVelocityZCoef * 
-                              ( 1.0 + ( (double_t)rand() / (double_t)RAND_MAX ) * coef );
+     return (uint64_t)generation | ( steadyState ? ( (uint64_t)1 << 63 ) : 0 );
+   } // CSimFireCore::RandomStream
 
-     std::string tmpOut = FormatStr( "MUTATING\n\n%s",
-       item.GetRunDesc() );
-     tmpOut += FormatStr( "\n----------------------------------\n[%f, %f, %f]\n\n",
-       newItem.mVelocityXCoef, newItem.mVelocityYCoef, newItem.mVelocityZCoef  );
-     WriteLogMessage( "CORE", tmpOut );
-   }
+   //-------------------------------------------------------------------------------------------------
+
+   double_t CSimFireCore::AverageMissDistance( const ListOfRunDescriptors_t & runParams )
+   {
+     size_t nCompleted = 0;
+     double_t avgDist = 0.0;
+     for( auto & item : runParams )
+       if( IsRunCompleted( item ) )
+       {
+         avgDist += std::sqrt( item.mMinDTgtSq );
+         ++nCompleted;
+       } // if
+     return avgDist / (double_t)std::max<size_t>( 1, nCompleted );
+   } // CSimFireCore::AverageMissDistance
 
    //-------------------------------------------------------------------------------------------------
 
-   void CSimFireCore::Hallucinate(
-     ListOfRunDescriptors_t & runParams,
-     size_t & fillingNewItem,
-     double_t coarseTuneCoef )
+   bool CSimFireCore::IsSurvivor( const CSimFireSingleRunParams & item, double_t avgDist )
    {
-     double_t distX = mSettings.GetTgtX() - mSettings.GetGunX();
-     double_t distY = mSettings.GetTgtY() - mSettings.GetGunY();
-     double_t distZ = mSettings.GetTgtZ() - mSettings.GetGunZ();
+     return IsRunCompleted( item ) &&
+       CSimFireSingleRunParams::SimResCode_t::kEndedCollision != item.mReturnCode &&
+       item.mMinDTgtSq < kAvgDistCutCoef * avgDist * avgDist;
+   } // CSimFireCore::IsSurvivor
+
+   //-------------------------------------------------------------------------------------------------
 
+   size_t CSimFireCore::PartitionResults( const ListOfRunDescriptors_t & runParams, double_t avgDist )
+   {
+     size_t excluded = 0;
+     std::array<size_t, kMissCategories> counts{};
+
+     mBreedingRecords.clear();
+     for( size_t runIdx = 0; runIdx < runParams.size(); ++runIdx )
+     {                  // Copies what breeding needs, so the original bunch can be overwritten by the
+                        // new generation
+       auto & item = runParams[runIdx];
+       if( !IsSurvivor( item, avgDist ) )
+       {
+         if( IsRunCompleted( item ) && CSimFireSingleRunParams::SimResCode_t::kEndedCollision != item.mReturnCode )
+           ++excluded;  // Too distant miss
+         continue;
+       } // if
 
-     if( IsPositive( mSettings.GetIniZCoef() ) )
-       distZ = mSettings.GetIniZCoef();
-     else
-       distZ *= 2.0;    // Initial elevation angle.  Bullet spray (bunches) will be
-                        // constructed around it.
+       MissCategory_t category;
+       if( item.mRaising )
+         category = item.mBelow ? kOverWhileRaising : kUnderWhileRaising;
+       else
+         category = item.mNearHalfPlane ? kNearWhileFalling : kFarWhileFalling;
 
-     if( fillingNewItem >= runParams.size() )
-       return;
-     auto & newItem = runParams[fillingNewItem++];
-     newItem.Reset();
-     newItem.mVelocityXCoef = distX;
-     newItem.mVelocityYCoef = distY;
-     newItem.mVelocityZCoef = distZ * ( 1.0 + ( (double_t)rand() / (double_t)RAND_MAX - 0.5 ) * coarseTuneCoef );
+       mBreedingRecords.push_back( BreedingRecord_t{ item.mMinDTgtSq, item.mVelocityXCoef,
+         item.mVelocityYCoef, item.mVelocityZCoef, (uint32_t)runIdx, category } );
+       ++counts[category];
+     } // for
 
-     std::string tmpOut = FormatStr( "FILLING BY RANDOM\n\n" );
-     tmpOut += FormatStr( "\n----------------------------------\n[%f, %f, %f]\n\n",
-       newItem.mVelocityXCoef, newItem.mVelocityYCoef, newItem.mVelocityZCoef );
-     WriteLogMessage( "CORE", tmpOut );
+     std::sort( mBreedingRecords.begin(), mBreedingRecords.end(),
+       []( const BreedingRecord_t & a, const BreedingRecord_t & b )
+       {
+         if( a.category != b.category )
+           return a.category < b.category;
+         if( a.distSq != b.distSq )
+           return a.distSq < b.distSq;
+         return a.runIdx < b.runIdx;
+       } );             // Index breaks ties, so the sort needs no buffer and is still deterministic
+
+     size_t first = 0;
+     for( size_t category = 0; category < kMissCategories; ++category )
+     {                  // Of runs with equal distance only the last one is kept, the category is moved
+                        // next to the previous one
+       mCategoryBegin[category] = mCategoryEnd[category] = ( 0 == category ) ? 0 : mCategoryEnd[category - 1];
+       for( size_t recordIdx = first; recordIdx < first + counts[category]; ++recordIdx )
+       {
+         if( recordIdx + 1 < first + counts[category] &&
+             mBreedingRecords[recordIdx + 1].distSq == mBreedingRecords[recordIdx].distSq )
+           continue;
+         mBreedingRecords[mCategoryEnd[category]++] = mBreedingRecords[recordIdx];
+       } // for
+       first += counts[category];
+     } // for
 
-	 } // CSimFireCore::Hallucinate
+     return excluded;
+
+   } // CSimFireCore::PartitionResults
 
    //-------------------------------------------------------------------------------------------------
 
-   void CSimFireCore::CreateFollowingGeneration( 
-     ListOfRunDescriptors_t & runParams, 
-     double_t avgDist,
-     size_t actGeneration )
+   CSimFireCore::BreedingStats_t CSimFireCore::PlanGeneration( size_t nSlots, double_t fineTuneCoef )
    {
+     BreedingStats_t stats{ 0, 0, 0, 0, 0 };
+     size_t nextSlot = 0;
 
-     std::map<double_t, CSimFireSingleRunParams> nearWhileFallingMiss;
-     std::map<double_t, CSimFireSingleRunParams> farWhileFallingMiss;
+     mBreedingPlan.clear();
+     auto addOp = [&]( BreedingOp_t op, size_t & counter )
+     {                  // Children which do not fit into the generation are not produced
+       if( nextSlot >= nSlots )
+         return;
+       op.firstSlot = (uint32_t)nextSlot;
+       op.nChildren = (uint8_t)std::min<size_t>( op.nChildren, nSlots - nextSlot );
+       nextSlot += op.nChildren;
+       counter += op.nChildren;
+       mBreedingPlan.push_back( op );
+     };
+
+     for( auto category : { kNearWhileFalling, kFarWhileFalling, kOverWhileRaising, kUnderWhileRaising } )
+       for( size_t rank = 0; rank < std::min( kSpawners, CategorySize( category ) ); ++rank )
+         addOp( BreedingOp_t{ kSpawn, 0, 3, CategoryRecord( category, rank ), 0, 0, fineTuneCoef }, stats.spawned );
+                        // The best results of each category are cloned and their elevations slightly
+                        // changed in the direction to the target
+
+     size_t nearFarPairs = std::min( CategorySize( kNearWhileFalling ), CategorySize( kFarWhileFalling ) );
+     for( size_t rank = 0; rank < nearFarPairs; ++rank )
+       addOp( BreedingOp_t{ kRecombine, 0, 3, CategoryRecord( kNearWhileFalling, rank ),
+         CategoryRecord( kFarWhileFalling, rank ), 0, 0.0 }, stats.recombined );
+                        // A simple GA recombination operator. It takes a pair of shots, one of which
+                        // is "long" and the other "short", and produces three new ones with elevations
+                        // between the original two (one slightly more than the arithmetic mean,
+                        // the other slightly less than the arithmetic mean). Works for "upper arc"
+                        // shooting.
 
-     std::map<double_t, CSimFireSingleRunParams> overWhileRaisingMiss;
-     std::map<double_t, CSimFireSingleRunParams> underWhileRaisingMiss;
+     size_t overUnderPairs = std::min( CategorySize( kOverWhileRaising ), CategorySize( kUnderWhileRaising ) );
+     for( size_t rank = 0; rank < overUnderPairs; ++rank )
+       addOp( BreedingOp_t{ kRecombine, 0, 3, CategoryRecord( kOverWhileRaising, rank ),
+         CategoryRecord( kUnderWhileRaising, rank ), 0, 0.0 }, stats.recombined );
+                        // The same for "above" and "under" shots, works for "direct line" shooting.
 
-     double_t avgDistCutCoef = 1.5;
-     double_t decCoef = 0.5;
-     double_t incCoef = 1.5;
-     double_t fineTuneCoef = 0.015;
-     double_t fineTuneDecay = 0.9;
+     std::pair<MissCategory_t, size_t> leftovers[] = { { kNearWhileFalling, nearFarPairs },
+       { kFarWhileFalling, nearFarPairs }, { kOverWhileRaising, overUnderPairs },
+       { kUnderWhileRaising, overUnderPairs } };
+     for( auto & [category, recombined] : leftovers )
+       for( size_t rank = recombined; rank < CategorySize( category ); ++rank )
+         addOp( BreedingOp_t{ kMutate, 0, 1, CategoryRecord( category, rank ), 0, 0,
+           kMutationCoefs[category] }, stats.mutated );
+                        // Leftovers not used by recombination are mutated (slight random increase of
+                        // elevation for near and under misses, decrease for far and over misses)
 
-     double_t zRatioRnd = 0.25;
-     size_t spawners = 2;
+     while( nextSlot < nSlots )
+       addOp( BreedingOp_t{ kRandom, 0, 1, 0, 0, 0, kZRatioRnd }, stats.random );
 
-     std::string tmpOut;
+     return stats;
 
-     for( auto it = runParams.begin(); it != runParams.end(); ++it )
-     {                  // Sorts results into categories for further processing and copies them, 
-                        // so original bunch can be overwritten by new generation.
-       if( it->mReturnCode == CSimFireSingleRunParams::SimResCode_t::kEndedCollision )
+   } // CSimFireCore::PlanGeneration
+
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::BreedChildren( const BreedingOp_t & op, ListOfRunDescriptors_t & runParams, uint64_t randomStream ) const
+   {
+     for( uint32_t childNr = 0; childNr < op.nChildren; ++childNr )
+     {
+       uint32_t slot = op.firstSlot + childNr;
+       auto & newItem = runParams[slot];
+       newItem.Reset();
+
+       if( kRandom == op.type )
+       {
+         double_t distZ = mSettings.GetTgtZ() - mSettings.GetGunZ();
+         if( IsPositive( mSettings.GetIniZCoef() ) )
+           distZ = mSettings.GetIniZCoef();
+         else
+           distZ *= 2.0;// Initial elevation angle.  Bullet spray (bunches) will be
+                        // constructed around it.
+
+         newItem.mVelocityXCoef = mSettings.GetTgtX() - mSettings.GetGunX();
+         newItem.mVelocityYCoef = mSettings.GetTgtY() - mSettings.GetGunY();
+         newItem.mVelocityZCoef = distZ * ( 1.0 + ( RandomUniform( mSeed, randomStream, slot ) - 0.5 ) * op.coef );
          continue;
+       } // if
+
+       auto & parent = mBreedingRecords[op.parent1];
 
-       if( it->mMinDTgtSq >= avgDistCutCoef * avgDist * avgDist )
+       if( kRecombine == op.type )
        {
-         WriteLogMessage( "CORE", FormatStr( "%s EXCLUDED as it is too distant", it->GetRunDesc() ) );
+         auto & parent2 = mBreedingRecords[op.parent2];
+         newItem.mVelocityXCoef = ( parent.aimX + parent2.aimX ) * 0.5;
+         newItem.mVelocityYCoef = ( parent.aimY + parent2.aimY ) * 0.5;
+
+         switch( op.firstChild + childNr )
+         {
+           case 0:
+             newItem.mVelocityZCoef = ( kIncCoef * parent.aimZ + kDecCoef * parent2.aimZ ) / ( kDecCoef + kIncCoef );
+             break;
+           case 1:
+             newItem.mVelocityZCoef = ( kDecCoef * parent.aimZ + kIncCoef * parent2.aimZ ) / ( kDecCoef + kIncCoef );
+             break;
+           default:
+             newItem.mVelocityZCoef = ( parent.aimZ + parent2.aimZ ) * 0.5;
+             break;
+         } // switch
          continue;
-			 } // if
+       } // if
+
+       newItem.mVelocityXCoef = parent.aimX;
+       newItem.mVelocityYCoef = parent.aimY;
 
-       if( it->mRaising )
+       if( kMutate == op.type )
        {
-         if( it->mBelow )
-           overWhileRaisingMiss[it->mMinDTgtSq] = *it;
-         else
-           underWhileRaisingMiss[it->mMinDTgtSq] = *it;
+         newItem.mVelocityZCoef = parent.aimZ * ( 1.0 + RandomUniform( mSeed, randomStream, slot ) * op.coef );
+         continue;
        } // if
+
+       double_t fineTune = (double_t)( op.firstChild + childNr ) * op.coef;
+       if( kOverWhileRaising == parent.category || kNearWhileFalling == parent.category )
+         newItem.mVelocityZCoef = parent.aimZ * ( 1.0 + fineTune );
        else
-       {
-         if( it->mNearHalfPlane )
-           nearWhileFallingMiss[it->mMinDTgtSq] = *it;
-         else
-           farWhileFallingMiss[it->mMinDTgtSq] = *it;
-       } // else
+         newItem.mVelocityZCoef = parent.aimZ * ( 1.0 - fineTune );
+                        // Spawning: the clone and elevations changed towards the target (up for runs
+                        // which went below it, down for those above)
 
      } // for
 
-     size_t fillingNewItem = 0;
+   } // CSimFireCore::BreedChildren
 
+   //-------------------------------------------------------------------------------------------------
+
+   CSimFireCore::BreedingStats_t CSimFireCore::BreedGeneration(
+     ListOfRunDescriptors_t & runParams,
+     double_t avgDist,
+     size_t actGeneration,
+     bool parallel )
+   {
+     double_t fineTuneCoef = kFineTuneCoef;
      for( uint32_t i = 0; i < actGeneration; ++i )
-       fineTuneCoef *= fineTuneDecay;
+       fineTuneCoef *= kFineTuneDecay;
 
-     Spawn( nearWhileFallingMiss, runParams, fillingNewItem, spawners, fineTuneCoef );
-     Spawn( farWhileFallingMiss, runParams, fillingNewItem, spawners, fineTuneCoef );
-		 Spawn( overWhileRaisingMiss, runParams, fillingNewItem, spawners, fineTuneCoef );
-		 Spawn( underWhileRaisingMiss, runParams, fillingNewItem, spawners, fineTuneCoef );
+     size_t excluded = PartitionResults( runParams, avgDist );
+     BreedingStats_t stats = PlanGeneration( runParams.size(), fineTuneCoef );
+     stats.excluded = excluded;
 
-     size_t cpairsNr = std::min( nearWhileFallingMiss.size(), farWhileFallingMiss.size() );
-     while( 0 < cpairsNr )
-     {                  // A simple GA recombination operator. It takes a pair of shots, one of which 
-                        // is "long" and the other "short", and produces three new ones with elevations 
-                        // between the original two (one slightly more than the arithmetic mean,
-                        // the other slightly less than the arithmetic mean). Works for "upper arc" 
-                        // shooting.
-       Recombine( nearWhileFallingMiss, farWhileFallingMiss, runParams, fillingNewItem, incCoef, decCoef );
-       --cpairsNr;
-     } // while
+     uint64_t randomStream = RandomStream( actGeneration + 1, false );
 
-     cpairsNr = std::min( overWhileRaisingMiss.size(), underWhileRaisingMiss.size() );
-     while( 0 < cpairsNr )
-     {                  // A simple GA recombination operator. It takes a pair of shots, one of which 
-                        // is "abovr" and the other "under", and produces three new ones with elevations 
-                        // between the original two (one slightly more than the arithmetic mean,
-                        // the other slightly less than the arithmetic mean). Works for "direct line" 
-                        // shooting.
-       Recombine( overWhileRaisingMiss, underWhileRaisingMiss, runParams, fillingNewItem, incCoef, decCoef );
-       --cpairsNr;
-     } // while
-       
-     for( auto nmItem: nearWhileFallingMiss )
-     {                  // Fill the rest of the new generation by mutating the best results from  
-                        // leftovers of the previous generation (slight random increase of elevation 
-                        // angle for near misses).
-       Mutate( nmItem.second, runParams, fillingNewItem, incCoef );
-     } // for
+     if( parallel && mWorkerPool && 1 < mWorkerPool->GetNumberOfWorkers() )
+       mWorkerPool->ForEachRange( mBreedingPlan.size(), ScheduleType_t::kStatic, 0,
+         [&]( size_t first, size_t last, uint32_t )
+         {
+           for( size_t opIdx = first; opIdx < last; ++opIdx )
+             BreedChildren( mBreedingPlan[opIdx], runParams, randomStream );
+         } );           // Each operation writes only its own slots, random numbers depend on slots
+     else
+       for( auto & op : mBreedingPlan )
+         BreedChildren( op, runParams, randomStream );
 
-     for( auto nmItem : farWhileFallingMiss )
-     {                  // Fill the rest of the new generation by mutating the best results from  
-                        // leftovers of the previous generation (slight random decrease of elevation 
-                        // angle for far misses).
-       Mutate( nmItem.second, runParams, fillingNewItem, decCoef );
-     } // for
+     return stats;
 
-     for( auto nmItem : overWhileRaisingMiss )
-     {                  // Fill the rest of the new generation by mutating the best results from  
-                        // leftovers of the previous generation (slight random decrease of elevation 
-                        // angle for above misses).
-       Mutate( nmItem.second, runParams, fillingNewItem, decCoef );
-     } // for
+   } // CSimFireCore::BreedGeneration
 
-     for( auto nmItem : underWhileRaisingMiss )
-     {                  // Fill the rest of the new generation by mutating the best results from  
-                        // leftovers of the previous generation (slight random decrease of elevation 
-                        // angle for under misses).
-       Mutate( nmItem.second, runParams, fillingNewItem, incCoef );
-     } // for
+   //-------------------------------------------------------------------------------------------------
 
-     while( fillingNewItem < runParams.size() )
+   void CSimFireCore::CreateFollowingGeneration( 
+     ListOfRunDescriptors_t & runParams, 
+     double_t avgDist,
+     size_t actGeneration )
+   {
+     auto start = std::chrono::steady_clock::now();
+
+     auto stats = BreedGeneration( runParams, avgDist, actGeneration, runParams.size() >= kParallelBreedingMin );
+
+     if( mTracer )
+       mTracer->AddSpan( 0, "CreateFollowingGeneration", "ga", mTracer->ToTracerTime( start ), mTracer->Now(),
+         FormatStr( "\"generation\":%zu,\"spawned\":%zu,\"recombined\":%zu,\"mutated\":%zu,\"random\":%zu",
+           actGeneration + 1, stats.spawned, stats.recombined, stats.mutated, stats.random ) );
+
+     SIMFIRE_LOG( *this, LogLevel_t::kDebug, "CORE", "New generation created in %.3f ms: %zu spawned, %zu recombined, "
+       "%zu mutated, %zu random runs (%zu runs excluded as too distant)",
+       1000.0 * std::chrono::duration<double_t>( std::chrono::steady_clock::now() - start ).count(),
+       stats.spawned, stats.recombined, stats.mutated, stats.random, stats.excluded );
+
+   } // CSimFireCore::CreateFollowingGeneration
+
+
+
+   //-------------------------------------------------------------------------------------------------
+
+   void CSimFireCore::ResetCancelRuns()
+   {
+     mCancelRuns.store( false );
+     if( mDeadlinePassed.load() )
+       mCancelRuns.store( true );
+                        // The watchdog sets the flag first and the token then, so the deadline passing
+                        // right now is never lost
+   } // CSimFireCore::ResetCancelRuns
+
+   //-------------------------------------------------------------------------------------------------
+
+   bool CSimFireCore::IsRunCompleted( const CSimFireSingleRunParams & item )
+   {
+     switch( item.mReturnCode )
      {
-       Hallucinate( runParams, fillingNewItem, zRatioRnd );
-		 } // while
+       case CSimFireSingleRunParams::SimResCode_t::kEndedNoActive:
+       case CSimFireSingleRunParams::SimResCode_t::kEndedCollision:
+       case CSimFireSingleRunParams::SimResCode_t::kEndedMaxTicks:
+       case CSimFireSingleRunParams::SimResCode_t::kEndedReceding:
+         return true;
+       default:
+         return false;
+     } // switch
+   } // CSimFireCore::IsRunCompleted
+
+   //-------------------------------------------------------------------------------------------------
+
+   const char * CSimFireCore::GetRunOutcome( const CSimFireSingleRunParams & item )
+   {
+     if( CSimFireSingleRunParams::SimResCode_t::kError == item.mReturnCode )
+       return "ERROR";
+     if( !IsRunCompleted( item ) )
+       return "CANCELLED";
+     return CSimFireSingleRunParams::SimResCode_t::kEndedCollision == item.mReturnCode ? "HIT" : "MISS";
+   } // CSimFireCore::GetRunOutcome
+
+   //-------------------------------------------------------------------------------------------------
+
+   bool CSimFireCore::UpdateBestRun( const CSimFireSingleRunParams & item )
+   {
+     if( !IsRunCompleted( item ) )
+       return false;    // Distance of runs which did not complete is not final
 
-     WriteLogMessage( "CORE", "\n\n****************************************\nNew generation "
-                              "created\n****************************************\n" );
+     bool itemHit = CSimFireSingleRunParams::SimResCode_t::kEndedCollision == item.mReturnCode;
+     bool bestHit = CSimFireSingleRunParams::SimResCode_t::kEndedCollision == mBestRun.mReturnCode;
 
+     if( CSimFireSingleRunParams::SimResCode_t::kNotStarted != mBestRun.mReturnCode &&
+         ( bestHit || ( !itemHit && item.mMinDTgtSq >= mBestRun.mMinDTgtSq ) ) )
+       return false;
+
+     mBestRun = item;
+     return true;
+
+   } // CSimFireCore::UpdateBestRun
+
+   //-------------------------------------------------------------------------------------------------
+
+   double_t CSimFireCore::SurvivorsSpread( const ListOfRunDescriptors_t & runParams )
+   {
+     double_t avgDist = AverageMissDistance( runParams );
+
+     size_t nSurvivors = 0;
+     double_t minZ = std::numeric_limits<double_t>::max();
+     double_t maxZ = std::numeric_limits<double_t>::lowest();
+     double_t sumZ = 0.0;
      for( auto & item : runParams )
-     {
-        WriteLogMessage( "CORE",
-          FormatStr( "Run firing at target with aim [%f, %f, %f]",
-             item.mVelocityXCoef, item.mVelocityYCoef, item.mVelocityZCoef  ) );
+     {                  // The same survivors as for breeding (see PartitionResults)
+       if( !IsSurvivor( item, avgDist ) )
+         continue;
+       ++nSurvivors;
+       minZ = std::min( minZ, item.mVelocityZCoef );
+       maxZ = std::max( maxZ, item.mVelocityZCoef );
+       sumZ += item.mVelocityZCoef;
      } // for
 
-     WriteLogMessage( "CORE", "\n\n****************************************\n" );
+     if( nSurvivors < 2 )
+       return std::numeric_limits<double_t>::max();
 
-   } // CSimFireCore::GenerateFollowingGeneration
+     return ( maxZ - minZ ) / std::max( gAlmostZero, std::fabs( sumZ / (double_t)nSurvivors ) );
 
+   } // CSimFireCore::SurvivorsSpread
 
    //-------------------------------------------------------------------------------------------------
 
    bool CSimFireCore::ContinueNextGAIteration( 
      const ListOfRunDescriptors_t & runParams, size_t actGeneration )
    {
-     if( mSettings.GetMaxGenerations() <= actGeneration )
-       return false;
-
      for( const auto & item : runParams )
      {
        if( item.mReturnCode == CSimFireSingleRunParams::SimResCode_t::kEndedCollision )
+       {
+         mStopReason = StopReason_t::kHit;
          return false;
+       } // if
      } // for
 
-     return true;
+     if( mDeadlinePassed.load() )
+       mStopReason = StopReason_t::kDeadline;
+     else if( mSettings.GetMaxGenerations() <= actGeneration )
+       mStopReason = StopReason_t::kMaxGenerations;
+     else if( IsPositive( mSettings.GetConvergenceTolerance() ) &&
+              SurvivorsSpread( runParams ) < mSettings.GetConvergenceTolerance() )
+       mStopReason = StopReason_t::kConverged;
+     else if( 0 < mSettings.GetStagnationLimit() && mStagnantGenerations >= mSettings.GetStagnationLimit() )
+       mStopReason = StopReason_t::kStagnation;
+
+     return StopReason_t::kNone == mStopReason;
 
    } // CSimFireCore::ContinueNextGAIteration
 
    //-------------------------------------------------------------------------------------------------
 
+   const std::string & CSimFireCore::GetStrValue( StopReason_t reason )
+   {
+     static const std::string lNone( "not stopped" );
+     static const std::string lHit( "target hit" );
+     static const std::string lMaxGenerations( "maximum number of generations reached" );
+     static const std::string lConverged( "population converged" );
+     static const std::string lStagnation( "best run stagnates" );
+     static const std::string lDeadline( "deadline passed" );
+     static const std::string lInvalidCode( "InvalidCode" );
+
+     switch( reason )
+     {
+       case StopReason_t::kNone:             return lNone;
+       case StopReason_t::kHit:              return lHit;
+       case StopReason_t::kMaxGenerations:   return lMaxGenerations;
+       case StopReason_t::kConverged:        return lConverged;
+       case StopReason_t::kStagnation:       return lStagnation;
+       case StopReason_t::kDeadline:         return lDeadline;
+       default:                              return lInvalidCode;
+     } // switch
+
+   } // CSimFireCore::GetStrValue
+
+   //-------------------------------------------------------------------------------------------------
+
 
 } // namespace PEGLDPCgenerator
@@ -10,15 +10,25 @@
 #ifndef H_CSimFireCore
 #define H_CSimFireCore
 
+#include <array>
+#include <atomic>
 #include <future>
 #include <mutex>
 
+#include <CSimFireEvalCache.h>
+#include <CSimFireLogger.h>
 #include <CSimFireSettings.h>
 #include <CSimFireSingleRun.h>
+#include <CSimFireTelemetry.h>
+#include <CSimFireTracer.h>
+#include <CSimFireWorkerPool.h>
 
 namespace SimFire
 {
 
+  class CSimFireBatchRun;
+  class CSimFireBenchmark;
+
   //***** CSimFireCore *******************************************************************************
 
   /*! \brief This class handles the core of the simulation engine. Finds best barrel angle to achieve
@@ -26,8 +36,21 @@ namespace SimFire
   class CSimFireCore
   {
 
+    friend class CSimFireBenchmark;
+                        // Benchmark measures cost of breeding on synthetic populations
+
   public:
 
+    enum class StopReason_t: uint8_t
+    {
+      kNone             = 0,    //!< Genetic algorithm has not stopped yet
+      kHit              = 1,    //!< A run hit the target
+      kMaxGenerations   = 2,    //!< Maximum number of generations (runs) was reached
+      kConverged        = 3,    //!< Z coefficients of survivors are within the convergence tolerance
+      kStagnation       = 4,    //!< The best run did not improve for given number of generations
+      kDeadline         = 5     //!< Wall time limit passed, runs in flight were cancelled
+    };
+
     //------------------------------------------------------------------------------------------------
     //! @name Constructors, destructor, clonning, assign operators                                   
     //@{----------------------------------------------------------------------------------------------
@@ -45,12 +68,33 @@ namespace SimFire
      
          \return true if simulation was successful, false otherwise */
 
-    void WriteLogMessage( const std::string & id, const std::string & mssg );
-    /*!< \brief Writes given message to log file (thread safe).
+    void WriteLogMessage( LogLevel_t level, const std::string & id, const std::string & mssg );
+    /*!< \brief Writes given message to log file (thread safe) if its level is enabled. Unless disabled
+         in settings, the message is only passed to the asynchronous logger (see CSimFireLogger) and
+         written by its thread. Warnings and errors are marked in the text. Use SIMFIRE_LOG to skip
+         formatting of disabled messages.
      
+         \param[in] level Severity of the message
          \param[in] id    Identifier of the message source (module, thread, ...)
          \param[in] mssg  Message text */
 
+    bool IsLogEnabled( LogLevel_t level ) const
+      { return gLogFloor <= level && mSettings.GetLogLevel() <= level; }
+    //!< \brief Returns true if messages of given level are logged (compiled in and enabled in settings)
+
+    const CSimFireSingleRunParams & GetBestRun() const { return mBestRun; }
+    /*!< \brief Returns the best run found by the last Run (a hit, or the miss nearest to the target),
+         its return code is NotStarted if no run was completed. */
+
+    StopReason_t GetStopReason() const { return mStopReason; }
+    //!< \brief Returns reason why the genetic algorithm of the last Run stopped
+
+    static const std::string & GetStrValue( StopReason_t reason );
+    /*!< \brief Returns string representation of given stop reason.
+
+         \param[in] reason Stop reason
+         \return String representation of the reason */
+
     //@{}---------------------------------------------------------------------------------------------
     //! @name Public data                                                                            
     //@{----------------------------------------------------------------------------------------------
@@ -64,15 +108,140 @@ namespace SimFire
                         //!< List of results of all runs in one generation (pair of run result code and 
                         //!  minimal distance to target)
 
+    //! Category of a missed run, given by flags of its closest approach to the target
+    enum MissCategory_t: uint8_t
+    {
+      kNearWhileFalling = 0,
+                        //!< Falling run which missed before the target
+      kFarWhileFalling = 1,
+                        //!< Falling run which missed behind the target
+      kOverWhileRaising = 2,
+                        //!< Rising run with the below flag set
+      kUnderWhileRaising = 3,
+                        //!< Rising run with the below flag cleared
+      kMissCategories = 4
+                        //!< Number of categories
+    };
+
+    //! Compact copy of a simulated run, only what breeding needs (no strings)
+    struct BreedingRecord_t {
+      double_t distSq;  //!< Squared minimal distance from the target [m^2]
+      double_t aimX;    //!< X coefficient of the aim vector
+      double_t aimY;    //!< Y coefficient of the aim vector
+      double_t aimZ;    //!< Z coefficient of the aim vector
+      uint32_t runIdx;  //!< Index of the run in its generation (orders runs with equal distance)
+      MissCategory_t category;
+                        //!< Category of the miss
+    };
+
+    //! Type of a breeding operation
+    enum BreedingOpType_t: uint8_t
+    {
+      kSpawn = 0,       //!< Clone of the parent and two slightly changed elevations
+      kRecombine = 1,   //!< Three elevations between the two parents
+      kMutate = 2,      //!< Randomly changed elevation of the parent
+      kRandom = 3       //!< Random run roughly pointing to the target
+    };
+
+    //! One breeding operation, produces a few consecutive new runs
+    struct BreedingOp_t {
+      BreedingOpType_t type;
+                        //!< Operator
+      uint8_t firstChild;
+                        //!< The first child of the operator produced (spawning without the clone starts at 1)
+      uint8_t nChildren;//!< Number of children produced
+      uint32_t parent1; //!< Index of the (first) parent in mBreedingRecords
+      uint32_t parent2; //!< Index of the second parent in mBreedingRecords (recombination only)
+      uint32_t firstSlot;
+                        //!< Index of the first new run in the generation
+      double_t coef;    //!< Size of the change (fine tune coefficient of spawning, mutation or random
+                        //!  coefficient)
+    };
+
+    //! Number of runs of each kind produced by breeding of one generation
+    struct BreedingStats_t {
+      size_t spawned;   //!< Runs spawned from the best runs of each category
+      size_t recombined;//!< Runs recombined from pairs of opposing categories
+      size_t mutated;   //!< Runs mutated from the leftovers
+      size_t random;    //!< Random runs filling the rest
+      size_t excluded;  //!< Runs of previous generation left out as too distant
+    };
+
+    bool RunSimulation();
+    /*!< \brief Runs the simulation (analytic solution or genetic algorithm), see Run.
+
+         \return true if simulation was successful, false otherwise */
+
+    void LogProcessorProfiles();
+    /*!< \brief Logs table of ticks, wall time and CPU cycles spent in each processor of single runs,
+         summed over all threads, and time of each thread (profiling builds only, see SimFireProfiler.h). */
+
+    void PrepareTelemetry();
+    /*!< \brief Creates the telemetry file if it is enabled in settings and writes description of the
+         simulation into it (a warning is logged and telemetry is skipped if the file cannot be created). */
+
+    static void AddRunToTelemetry( CSimFireTelemetry::Record_t & record, const CSimFireSingleRunParams & item );
+    /*!< \brief Adds outcome of a finished run to statistics of the generation: hit, cancelled or failed
+         run, the least miss distance and sum of miss distances of completed runs.
+
+         \param[in,out] record Statistics of the generation
+         \param[in]     item   Finished run */
+
+    void WriteTelemetry( CSimFireTelemetry::Record_t & record, const ListOfRunDescriptors_t & population );
+    /*!< \brief Completes statistics of the generation (average miss distance from the sum collected by
+         AddRunToTelemetry, spread of survivors of the population) and writes them into the telemetry file.
+
+         \param[in,out] record     Statistics of the generation, all runs of it are added by AddRunToTelemetry
+         \param[in]     population Runs of the generation (or the retained population in steady-state mode) */
+
+    void PrepareTracer();
+    /*!< \brief Creates the tracer if tracing is enabled in settings and names its tracks (the main thread
+         and pool workers). */
+
+    void FinishTracer();
+    /*!< \brief Writes timeline recorded by the tracer into the file given in settings and destroys the
+         tracer (workers must be idle). */
+
+    void PrepareWorkers();
+    /*!< \brief Creates the worker pool and run workers of pool workers (if not created yet). */
+
+    bool SolveAnalytically();
+    /*!< \brief Solves elevation of the shot directly (low and high arc) for a flight in vacuum and
+         evaluates both solutions in closed form, optionally cross-checked by simulation with Euler
+         integrator. Replaces the genetic algorithm when analytic integrator is chosen.
+
+         \return true if the solution was successful, false otherwise */
+
     void RunBunch(
       ListOfRunDescriptors_t::iterator runParamsBegin,
       ListOfRunDescriptors_t::iterator runParamsEnd,
-      const std::string & threadId );
+      const std::string & threadId,
+      uint32_t workerIdx );
     /*!< \brief Runs a bunch of simulations in one thread.
      
          \param[in] runParamsBegin  Iterator to the beginning of the list of run parameters
          \param[in] runParamsEnd    Iterator to the end of the list of run parameters
-         \param[in] threadId        Identifier of the thread */
+         \param[in] threadId        Identifier of the thread
+         \param[in] workerIdx       Index of the pool worker, selects its persistent run workers */
+
+    bool UseBatchEngine() const;
+    /*!< \brief Returns true if runs are simulated by the batch engine (requested in settings and
+         supported for chosen integrator and options), false if by single runs. */
+
+    void PredictRunCosts( const ListOfRunDescriptors_t & runParams, std::vector<double_t> & costs ) const;
+    /*!< \brief Predicts number of ticks of each run for longest first schedule. Runs of the following
+         generations get measured number of ticks of the previous generation run with the nearest
+         elevation (children stay close to their parents), the initial generation gets vacuum flight
+         time estimated from the aim vector.
+
+         \param[in]  runParams List of run parameters
+         \param[out] costs     Predicted cost of each run */
+
+    void StoreRunCosts( const ListOfRunDescriptors_t & runParams );
+    /*!< \brief Stores measured number of ticks of simulated runs for prediction of costs of the
+         following generation (see PredictRunCosts).
+
+         \param[in] runParams List of simulated run parameters */
 
     void GenerateInitialGeneration( ListOfRunDescriptors_t & runParams );
     /*!< \brief Generates initial generation of runs with random parameters above the line of sight
@@ -85,69 +254,150 @@ namespace SimFire
       double_t avgDist,
       size_t actGeneration );
     /*!< \brief Creates following generation of runs based on results of previous generation using
-         genetic algorithm methods (see below).
+         genetic algorithm methods (see BreedGeneration) and logs the summary. Children are produced
+         in parallel for large generations.
      
          \param[in,out] runParams      List of run parameters to be filled
          \param[in]     avgDist        Average distance of all runs in previous generation
          \param[in]     actGeneration  Number of actual generation (0 for initial generation) */
 
-    void Spawn(
-      std::map<double_t, CSimFireSingleRunParams> & queue,
+    BreedingStats_t BreedGeneration(
       ListOfRunDescriptors_t & runParams,
-      size_t & fillingNewItem,
-			size_t spawners,
-      double_t fineTuneCoef );
-    /*!< \brief Spawns new runs by slight mutation of the best results from previous generation.
-     
-         \param[in]     queue           Sorted map of best results from previous generation
-         \param[in,out] runParams      List of run parameters to be filled
-         \param[in,out] fillingNewItem Index of the next item to be filled in runParams
-         \param[in]     spawners       Number of new runs to be spawned from one best result
-         \param[in]     fineTuneCoef   Coefficient determining the size of mutation */
+      double_t avgDist,
+      size_t actGeneration,
+      bool parallel );
+    /*!< \brief Breeds following generation in place of the previous one. Results are partitioned into
+         compact records (see PartitionResults), then the operations are planned serially (see
+         PlanGeneration), so that each of them knows its parents and slots of its children, and finally
+         the children are produced, in parallel by the worker pool if requested. The result does not
+         depend on the number of threads. Nothing is logged.
 
-    void Recombine(
-      std::map<double_t, CSimFireSingleRunParams> & queue1,
-      std::map<double_t, CSimFireSingleRunParams> & queue2,
-      ListOfRunDescriptors_t & runParams,
-      size_t & fillingNewItem,
-      double_t incCoef,
-      double_t decCoef );
-    /*!< \brief Recombines pairs of "long"/"short" or "below"/"above" results from previous generation 
-         to produce new runs with elevation angles between the original pair.
-     
-         \param[in]     queue1         Sorted map of "long" results from previous generation
-         \param[in]     queue2         Sorted map of "short" results from previous generation
-         \param[in,out] runParams      List of run parameters to be filled
-         \param[in,out] fillingNewItem Index of the next item to be filled in runParams
-         \param[in]     incCoef        Coefficient determining how much the higher new elevation angle
-                                       is above the arithmetic mean of the original pair
-         \param[in]     decCoef        Coefficient determining how much the lower new elevation angle
-                                       is below the arithmetic mean of the original pair */
-
-    void Mutate(
-      CSimFireSingleRunParams & item,
-      ListOfRunDescriptors_t & runParams,
-      size_t & fillingNewItem,
-      double_t coef );
-    /*!< \brief Mutates given run parameters slightly to produce a new run.
-     
-         \param[in]     item           Run parameters to be mutated
-         \param[in,out] runParams      List of run parameters to be filled
-         \param[in,out] fillingNewItem Index of the next item to be filled in runParams
-         \param[in]     coef           Coefficient determining the amount of mutation */
+         \param[in,out] runParams      Previous generation, replaced by the following one
+         \param[in]     avgDist        Average distance of all runs in previous generation
+         \param[in]     actGeneration  Number of actual generation (0 for initial generation)
+         \param[in]     parallel       If true, children are produced by the worker pool
+         \return Number of runs produced by each operator */
 
-    void Hallucinate(
-      ListOfRunDescriptors_t & runParams,
-      size_t & fillingNewItem,
-      double_t coarseTuneCoef );
-    /*!< \brief Produces a completely random run roughly pointing to the target direction.
-     
-         \param[in,out] runParams      List of run parameters to be filled
-         \param[in,out] fillingNewItem Index of the next item to be filled in runParams
-         \param[in]     coarseTuneCoef Coefficient determining the amount of randomness */
+    static double_t AverageMissDistance( const ListOfRunDescriptors_t & runParams );
+    /*!< \brief Returns average distance of completed runs from the target (see IsRunCompleted), runs
+         which did not complete are left out, their distance is not final.
+
+         \param[in] runParams List of simulated runs
+         \return Average distance [m], zero if no run completed */
+
+    static bool IsSurvivor( const CSimFireSingleRunParams & item, double_t avgDist );
+    /*!< \brief Returns true if the run survives to breeding: it completed, missed the target and is not
+         too distant compared to the average. Used both by breeding and by the convergence test.
+
+         \param[in] item    Simulated run
+         \param[in] avgDist Average distance of completed runs (see AverageMissDistance)
+         \return true if the run survives */
+
+    size_t PartitionResults( const ListOfRunDescriptors_t & runParams, double_t avgDist );
+    /*!< \brief Copies survivors (see IsSurvivor) to compact records in mBreedingRecords, partitioned into
+         categories (see MissCategory_t) by flags of their closest approach and sorted within each category
+         by distance from the target (only the last of runs with equal distance is kept). Nothing is
+         allocated once the buffers are large enough.
+
+         \param[in] runParams List of simulated runs
+         \param[in] avgDist   Average distance of completed runs (see AverageMissDistance)
+         \return Number of completed misses left out as too distant */
+
+    size_t CategorySize( MissCategory_t category ) const
+      { return mCategoryEnd[category] - mCategoryBegin[category]; }
+    //!< \brief Returns number of records of given category (see PartitionResults)
+
+    uint32_t CategoryRecord( MissCategory_t category, size_t rank ) const
+      { return (uint32_t)( mCategoryBegin[category] + rank ); }
+    //!< \brief Returns index of the record of given category and rank (0 is the nearest to the target)
+
+    BreedingStats_t PlanGeneration( size_t nSlots, double_t fineTuneCoef );
+    /*!< \brief Plans operations breeding the following generation into mBreedingPlan: spawning from the
+         two best runs of each category, recombination of near/far and over/under pairs, mutation of
+         leftovers and random runs for the rest of slots.
+
+         \param[in] nSlots       Number of runs in the generation
+         \param[in] fineTuneCoef Coefficient determining the size of spawning mutation
+         \return Number of runs produced by each operator (excluded runs are not filled) */
+
+    void BreedChildren( const BreedingOp_t & op, ListOfRunDescriptors_t & runParams, uint64_t randomStream ) const;
+    /*!< \brief Produces children of one operation into their slots. Reads only records and settings,
+         so operations may be processed by several threads at once.
+
+         \param[in]     op           Breeding operation
+         \param[in,out] runParams    List of run parameters to be filled
+         \param[in]     randomStream Stream of random numbers (see RandomStream), the number is given
+                                     by the stream and index of the new run */
+
+    size_t RunSteadyState( ListOfRunDescriptors_t & runParams, const std::vector<std::string> & threadIds );
+    /*!< \brief Runs steady-state genetic algorithm: there are no generations, result of each run
+         enters the population (of generation size, the worst run is dropped) as soon as the run
+         ends and the worker is immediately given a new offspring bred from the actual population.
+         Ends with the first hit or when as many runs as in all generations were simulated.
+
+         \param[in,out] runParams Initial runs, on return the final population (and the hit, if any)
+         \param[in]     threadIds Identifiers of pool workers
+         \return Number of simulated runs */
+
+    void BreedOffspring(
+      const ListOfRunDescriptors_t & population,
+      size_t breedingNr,
+      double_t fineTuneCoef,
+      ListOfRunDescriptors_t & offspring );
+    /*!< \brief Breeds a few new runs from the population for steady-state genetic algorithm. The same
+         operators as for generations are used in turns (recombination of opposing categories, spawning
+         from the best run, mutation of the best run of a category), a random run if none applies.
+
+         \param[in]  population   Actual population (simulated runs)
+         \param[in]  breedingNr   Number of the breeding, selects the operator
+         \param[in]  fineTuneCoef Coefficient determining the size of spawning mutation
+         \param[out] offspring    New runs */
+
+    static uint64_t RandomStream( size_t generation, bool steadyState );
+    /*!< \brief Returns stream of random numbers used for breeding. Numbers depend only on the seed,
+         the stream and index of the new chromosome, never on order of calls nor number of threads.
+
+         \param[in] generation  Number of the generation being created (number of the breeding for
+                                steady-state genetic algorithm)
+         \param[in] steadyState True for steady-state genetic algorithm (separate streams)
+         \return Stream of random numbers */
+
+    void ResetCancelRuns();
+    /*!< \brief Clears cancellation token of runs before a generation (or the steady-state GA), unless
+         the deadline has already passed. */
+
+    static bool IsRunCompleted( const CSimFireSingleRunParams & item );
+    /*!< \brief Returns true if the run completed, i.e. its miss distance and flags are final. Runs which
+         were cancelled, not started at all or failed keep the initial (huge) distance.
+
+         \param[in] item Simulated run
+         \return true if the run completed */
+
+    static const char * GetRunOutcome( const CSimFireSingleRunParams & item );
+    /*!< \brief Returns label of the run for listings: HIT, MISS, ERROR (integrator failed) or CANCELLED
+         (run was cancelled or not started).
+
+         \param[in] item Simulated run
+         \return Label of the run */
+
+    bool UpdateBestRun( const CSimFireSingleRunParams & item );
+    /*!< \brief Keeps the run as the best one found so far if it is better (a hit beats any miss, a miss
+         nearer to the target beats a more distant one). Runs which did not complete are ignored.
+
+         \param[in] item Simulated run
+         \return true if the run became the best one */
+
+    static double_t SurvivorsSpread( const ListOfRunDescriptors_t & runParams );
+    /*!< \brief Returns relative spread (max - min) / mean of Z coefficients of runs which would survive
+         to breeding (see IsSurvivor).
+
+         \param[in] runParams List of simulated runs
+         \return Relative spread, a huge number if there are less than two survivors */
 
     bool ContinueNextGAIteration( const ListOfRunDescriptors_t & runParams, size_t actGeneration );
-    /*!< \brief Decides whether the genetic algorithm should continue to next iteration or stop.
+    /*!< \brief Decides whether the genetic algorithm should continue to next iteration or stop: it stops
+         on a hit, deadline, maximum number of generations, convergence of survivors or stagnation of
+         the best run (see CSimFireSettings). The reason is kept in mStopReason.
      
          \param[in] runParams      List of run parameters of actual generation
          \param[in] actGeneration  Number of actual generation (0 for initial generation)
@@ -157,7 +407,60 @@ namespace SimFire
     //<! Reference to settings object
 
     std::recursive_mutex mLogMutex;
-    //<! Mutex for thread-safe logging
+    //<! Mutex for thread-safe logging (synchronous logging only)
+
+    std::unique_ptr<CSimFireLogger> mLogger;
+    //<! Asynchronous logger (created only if enabled in settings)
+
+    std::vector<std::unique_ptr<CSimFireSingleRun>> mRunWorkers;
+    //<! Run worker of each pool worker, kept warm between generations
+
+    std::vector<std::unique_ptr<CSimFireBatchRun>> mBatchWorkers;
+    //<! Batch engine of each pool worker (created on first use)
+
+    uint64_t mSeed;     //<! Seed of random numbers (given by the user or taken from time)
+
+    std::atomic<bool> mCancelRuns;
+    //<! Cancellation token of runs of the actual generation (set by the first hit, see
+    //!  CSimFireSettings::GetStopOnFirstHit, or by the deadline)
+
+    std::atomic<bool> mDeadlinePassed;
+    //<! Set when wall time limit of the genetic algorithm passes (see CSimFireSettings::GetDeadline)
+
+    CSimFireSingleRunParams mBestRun;
+    //<! The best run found so far (see UpdateBestRun)
+
+    size_t mStagnantGenerations;
+    //<! Number of last generations which did not improve the best run
+
+    StopReason_t mStopReason;
+    //<! Reason why the genetic algorithm stopped
+
+    std::unique_ptr<CSimFireEvalCache> mEvalCache;
+    //<! Results of already simulated runs (created only if enabled in settings)
+
+    std::unique_ptr<CSimFireTelemetry> mTelemetry;
+    //<! Telemetry of generations of the actual simulation (created only if enabled in settings)
+
+    std::unique_ptr<CSimFireTracer> mTracer;
+    //<! Timeline of the actual simulation (created only if enabled in settings, see PrepareTracer)
+
+    std::vector<std::pair<double_t, double_t>> mMeasuredCosts;
+    //<! Elevation of the aim vector and number of ticks of runs of the last generation, sorted by elevation
+
+    std::vector<BreedingRecord_t> mBreedingRecords;
+    //<! Compact records of runs of the last bred generation (see PartitionResults), reused by all breedings
+
+    std::array<size_t, kMissCategories> mCategoryBegin;
+    std::array<size_t, kMissCategories> mCategoryEnd;
+    //<! Range of records of each category in mBreedingRecords
+
+    std::vector<BreedingOp_t> mBreedingPlan;
+    //<! Operations breeding the following generation (see PlanGeneration)
+
+    std::unique_ptr<CSimFireWorkerPool> mWorkerPool;
+    //<! Worker threads, created once and reused by all generations (declared last, so that threads
+    //!  are joined before run workers are destroyed)
 
     //@}
 
@@ -0,0 +1,152 @@
+//****************************************************************************************************
+//! \file CSimFireEvalCache.cpp
+//! Module contains definitions of CSimFireEvalCache class, declared in CSimFireEvalCache.h, which
+//! is a cache of results of already simulated runs.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <bit>
+#include <cmath>
+
+#include <CSimFireEvalCache.h>
+
+namespace SimFire
+{
+
+  constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+  constexpr uint64_t kFnvPrime = 1099511628211ull;
+                        // Parameters of FNV-1a hash
+
+  static void FnvAdd( uint64_t & hash, uint64_t value )
+  {                     // Value is hashed byte by byte
+    for( int byte = 0; byte < 8; ++byte, value >>= 8 )
+    {
+      hash ^= ( value & 0xFF );
+      hash *= kFnvPrime;
+    } // for
+  } // FnvAdd
+
+  //-------------------------------------------------------------------------------------------------
+
+  static void FnvAdd( uint64_t & hash, double_t value )
+  {
+    FnvAdd( hash, std::bit_cast<uint64_t>( value ) );
+  } // FnvAdd
+
+  //****** CSimFireEvalCache *************************************************************************
+
+  CSimFireEvalCache::CSimFireEvalCache( const CSimFireSettings & settings ):
+    mTolerance( settings.GetCacheTolerance() ),
+    mFingerprint( SettingsFingerprint( settings ) ),
+    mEntries(),
+    mHits( 0 )
+  {} // CSimFireEvalCache::CSimFireEvalCache
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireEvalCache::~CSimFireEvalCache() = default;
+
+  //-------------------------------------------------------------------------------------------------
+
+  bool CSimFireEvalCache::Lookup( CSimFireSingleRunParams & runParams )
+  {
+    auto it = mEntries.find( MakeKey( runParams ) );
+    if( it == mEntries.end() )
+      return false;
+
+    auto runLabel = runParams.mRunLabel;
+    auto runNr = runParams.mRunNr;
+    runParams = it->second;
+    runParams.mRunLabel = runLabel;
+    runParams.mRunNr = runNr;
+    runParams.mThreadLabel = CSimFireSingleRunParams::ThreadLabel_t::kCache;
+    runParams.mThreadNr = 0;
+    ++mHits;
+    return true;
+
+  } // CSimFireEvalCache::Lookup
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireEvalCache::Store( const CSimFireSingleRunParams & runParams )
+  {
+    if( CSimFireSingleRunParams::SimResCode_t::kCancelled == runParams.mReturnCode ||
+        CSimFireSingleRunParams::SimResCode_t::kNotStarted == runParams.mReturnCode ||
+        CSimFireSingleRunParams::SimResCode_t::kRunning == runParams.mReturnCode )
+      return;           // Not a result of the whole flight
+
+    mEntries.try_emplace( MakeKey( runParams ), runParams );
+
+  } // CSimFireEvalCache::Store
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireEvalCache::Clear()
+  {
+    mEntries.clear();
+    mHits = 0;
+  } // CSimFireEvalCache::Clear
+
+  //-------------------------------------------------------------------------------------------------
+
+  uint64_t CSimFireEvalCache::SettingsFingerprint( const CSimFireSettings & settings )
+  {
+    uint64_t hash = kFnvOffset;
+
+    for( double_t value : { settings.GetGunX(), settings.GetGunY(), settings.GetGunZ(), settings.GetVelocity(),
+      settings.GetCd(), settings.GetMass(), settings.GetBulletSize(), settings.GetTgtX(), settings.GetTgtY(),
+      settings.GetTgtZ(), settings.GetTgtSize(), settings.GetG(), settings.GetDensity(), settings.GetDt(),
+      settings.GetAbsTolerance(), settings.GetRelTolerance() } )
+      FnvAdd( hash, value );
+
+    for( uint64_t value : { (uint64_t)settings.GetIntegrator(), (uint64_t)settings.GetContinuousCollisions(),
+      (uint64_t)settings.GetSubTickApproach(), (uint64_t)settings.GetRecedingTermination(),
+      (uint64_t)settings.GetFusedKernel(), (uint64_t)settings.GetBatchEngine() } )
+      FnvAdd( hash, value );
+                        // Fused kernel and batch engine give the same results, but the cache does not
+                        // rely on it
+
+    return hash;
+
+  } // CSimFireEvalCache::SettingsFingerprint
+
+  //-------------------------------------------------------------------------------------------------
+
+  size_t CSimFireEvalCache::KeyHash_t::operator()( const Key_t & key ) const
+  {
+    uint64_t hash = kFnvOffset;
+    FnvAdd( hash, (uint64_t)key.x );
+    FnvAdd( hash, (uint64_t)key.y );
+    FnvAdd( hash, (uint64_t)key.z );
+    FnvAdd( hash, key.fingerprint );
+    return (size_t)hash;
+  } // CSimFireEvalCache::KeyHash_t::operator()
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireEvalCache::Key_t CSimFireEvalCache::MakeKey( const CSimFireSingleRunParams & runParams ) const
+  {
+    double_t div = std::sqrt(
+      runParams.mVelocityXCoef * runParams.mVelocityXCoef +
+      runParams.mVelocityYCoef * runParams.mVelocityYCoef +
+      runParams.mVelocityZCoef * runParams.mVelocityZCoef );
+    if( IsZero( div ) )
+      div = 1.0;        // Such run ends with an error, any key will do
+
+    auto quantize = [this]( double_t value ) -> int64_t
+    {
+      if( IsPositive( mTolerance, 0.0 ) )
+        return std::llround( value / mTolerance );
+      return std::bit_cast<int64_t>( value + 0.0 );
+                        // Exact match, negative zero is treated as zero
+    };
+
+    return Key_t{ quantize( runParams.mVelocityXCoef / div ), quantize( runParams.mVelocityYCoef / div ),
+      quantize( runParams.mVelocityZCoef / div ), mFingerprint };
+
+  } // CSimFireEvalCache::MakeKey
+
+} // namespace SimFire
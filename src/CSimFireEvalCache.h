@@ -0,0 +1,125 @@
+//****************************************************************************************************
+//! \file CSimFireEvalCache.h
+//! Module contains declaration of CSimFireEvalCache class, a cache of results of already simulated
+//! runs, so that identical and near-identical chromosomes are not simulated again.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_CSimFireEvalCache
+#define H_CSimFireEvalCache
+
+#include <unordered_map>
+
+#include <SimFireGlobals.h>
+#include <CSimFireSettings.h>
+#include <CSimFireSingleRunParams.h>
+
+namespace SimFire
+{
+
+  //***** CSimFireEvalCache **************************************************************************
+
+  /*!  \brief Cache of results of simulated runs. Results are keyed by the direction of the aim vector
+       (only direction matters, the bullet always gets the muzzle velocity) quantized by given
+       tolerance, and by fingerprint of settings which affect the flight, so a result is never reused
+       for a different scenario. Elites cloned into the following generation and mutations smaller than
+       the tolerance are then taken from the cache instead of being simulated again.
+
+       The cache is not thread-safe, it is used only by the thread which dispatches runs. */
+  class CSimFireEvalCache
+  {
+
+  public:
+
+    //------------------------------------------------------------------------------------------------
+    //! @name Constructors, destructor, clonning, assign operators
+    //@{----------------------------------------------------------------------------------------------
+
+    CSimFireEvalCache( const CSimFireSettings & settings );
+    /*!< \brief Creates empty cache for the scenario given by settings.
+
+         \param[in] settings Settings of the simulation (tolerance and fingerprint are taken from it) */
+
+    virtual ~CSimFireEvalCache();
+
+    //@}-----------------------------------------------------------------------------------------------
+    //! @name Public methods  */
+    //@{-----------------------------------------------------------------------------------------------
+
+    bool Lookup( CSimFireSingleRunParams & runParams );
+    /*!< \brief Searches the cache for a result of run with the same (quantized) aim vector. If found,
+         results (and the aim vector of the simulated run) are copied to given run, its identifier
+         is kept and the thread label is set to CACHE.
+
+         \param[in,out] runParams Run to be searched for, filled with cached results if found
+         \return true if the result was found in the cache */
+
+    void Store( const CSimFireSingleRunParams & runParams );
+    /*!< \brief Stores result of simulated run. Cancelled and not finished runs are not stored, an
+         already stored result is kept.
+
+         \param[in] runParams Simulated run */
+
+    void Clear();
+    //!< \brief Removes all stored results and resets the statistics
+
+    uint64_t GetHits() const { return mHits; }
+    //!< \brief Returns number of successful lookups since the last Clear
+
+    size_t GetSize() const { return mEntries.size(); }
+    //!< \brief Returns number of stored results
+
+    static uint64_t SettingsFingerprint( const CSimFireSettings & settings );
+    /*!< \brief Computes fingerprint (FNV-1a hash) of all settings which affect result of a run.
+
+         \param[in] settings Settings of the simulation
+         \return Fingerprint of the settings */
+
+    //@}---------------------------------------------------------------------------------------------
+    //! @name Protected data
+    //@{----------------------------------------------------------------------------------------------
+
+  protected:
+
+    //! Key of a cached result
+    struct Key_t {
+      int64_t x;        //!< Quantized X component of the unit aim vector
+      int64_t y;        //!< Quantized Y component of the unit aim vector
+      int64_t z;        //!< Quantized Z component of the unit aim vector
+      uint64_t fingerprint;
+                        //!< Fingerprint of settings (see SettingsFingerprint)
+
+      bool operator==( const Key_t & other ) const = default;
+    };
+
+    //! Hash of the key (FNV-1a over its members)
+    struct KeyHash_t {
+      size_t operator()( const Key_t & key ) const;
+    };
+
+    Key_t MakeKey( const CSimFireSingleRunParams & runParams ) const;
+    /*!< \brief Builds the key of given run.
+
+         \param[in] runParams Run parameters (aim vector)
+         \return Key of the run */
+
+    double_t mTolerance;//!< Quantization step of unit aim vector components, exact match if zero
+
+    uint64_t mFingerprint;
+                        //!< Fingerprint of settings the cache was created for
+
+    std::unordered_map<Key_t, CSimFireSingleRunParams, KeyHash_t> mEntries;
+                        //!< Stored results
+
+    uint64_t mHits;     //!< Number of successful lookups
+
+    //@}
+
+  }; // CSimFireEvalCache
+
+} // namespace SimFire
+
+#endif
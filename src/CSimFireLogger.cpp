@@ -0,0 +1,288 @@
+//****************************************************************************************************
+//! \file CSimFireLogger.cpp
+//! Module contains definitions of CSimFireLogger class, declared in CSimFireLogger.h, which is
+//! an asynchronous logging backend.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+#include <CSimFireLogger.h>
+
+namespace SimFire
+{
+
+  constexpr auto kWriterPeriod = std::chrono::milliseconds( 2 );
+                        // Longest time a message waits in the ring before the writer takes it
+
+  static std::atomic<uint64_t> sNextLoggerId( 1 );
+                        // Loggers get unique identifiers, so that a ring cached by a thread is never
+                        // mistaken for a ring of another logger created at the same address
+
+  //****** CSimFireLogger ****************************************************************************
+
+  CSimFireLogger::CSimFireLogger( std::ostream & out, size_t bufferSize, LogOverflow_t overflow ):
+    mOut( out ),
+    mMask( std::bit_ceil( std::max<size_t>( bufferSize, 2 ) ) - 1 ),
+    mOverflow( overflow ),
+    mLoggerId( sNextLoggerId.fetch_add( 1, std::memory_order_relaxed ) ),
+    mNextSeq( 0 ),
+    mWritten( 0 ),
+    mRingsMutex(),
+    mRings(),
+    mWakeRequested( false ),
+    mWriterMutex(),
+    mWakeUp(),
+    mFlushed(),
+    mFlushRequests( 0 ),
+    mFlushesDone( 0 ),
+    mStop( false ),
+    mDrainRings(),
+    mDrainBatch(),
+    mDrainText(),
+    mWriter()
+  {
+    mWriter = std::thread( &CSimFireLogger::WriterLoop, this );
+  } // CSimFireLogger::CSimFireLogger
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireLogger::~CSimFireLogger()
+  {
+    {
+      std::lock_guard lock( mWriterMutex );
+      mStop = true;
+    }
+    mWakeUp.notify_one();
+    if( mWriter.joinable() )
+      mWriter.join();   // The writer makes one more pass after it sees the stop request
+  } // CSimFireLogger::~CSimFireLogger
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireLogger::Write( const std::string & id, const std::string & mssg )
+  {
+    Ring_t & ring = GetRing();
+    uint64_t head = ring.head.load( std::memory_order_relaxed );
+    uint64_t tail = ring.tail.load( std::memory_order_acquire );
+
+    while( mMask < head - tail )
+    {                   // Ring is full
+      if( LogOverflow_t::kDrop == mOverflow )
+      {
+        ring.dropped.fetch_add( 1, std::memory_order_relaxed );
+        return;
+      } // if
+
+      mWakeRequested.store( true, std::memory_order_relaxed );
+      mWakeUp.notify_one();
+      std::this_thread::yield();
+      tail = ring.tail.load( std::memory_order_acquire );
+    } // while
+
+    Slot_t & slot = ring.slots[head & mMask];
+    slot.seq = mNextSeq.fetch_add( 1, std::memory_order_acq_rel );
+                        // The ring is registered before, so the writer sees it with the sequence number
+    slot.text.clear();
+    slot.text.push_back( '[' );
+    slot.text.append( id );
+    slot.text.append( "]   " );
+    slot.text.append( mssg );
+    slot.text.push_back( '\n' );
+                        // The slot keeps capacity of its string, so nothing is allocated once warm
+    ring.head.store( head + 1, std::memory_order_release );
+
+    if( head + 1 - tail == ( mMask + 1 ) / 2 )
+    {                   // Half full, the writer is woken up sooner than by its period
+      mWakeRequested.store( true, std::memory_order_relaxed );
+      mWakeUp.notify_one();
+    } // if
+
+  } // CSimFireLogger::Write
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireLogger::Flush()
+  {
+    std::unique_lock lock( mWriterMutex );
+    uint64_t request = ++mFlushRequests;
+    mWakeUp.notify_one();
+    mFlushed.wait( lock, [&]() { return request <= mFlushesDone; } );
+  } // CSimFireLogger::Flush
+
+  //-------------------------------------------------------------------------------------------------
+
+  uint64_t CSimFireLogger::GetDropped() const
+  {
+    std::lock_guard lock( mRingsMutex );
+    uint64_t dropped = 0;
+    for( const auto & ring : mRings )
+      dropped += ring->dropped.load( std::memory_order_relaxed );
+    return dropped;
+  } // CSimFireLogger::GetDropped
+
+  //-------------------------------------------------------------------------------------------------
+
+  const std::string & CSimFireLogger::GetStrValue( LogOverflow_t overflow )
+  {
+    static const std::string lBlock( "block" );
+    static const std::string lDrop( "drop" );
+    static const std::string lInvalidCode( "InvalidCode" );
+
+    switch( overflow )
+    {
+      case LogOverflow_t::kBlock: return lBlock;
+      case LogOverflow_t::kDrop:  return lDrop;
+      default:                    return lInvalidCode;
+    } // switch
+
+  } // CSimFireLogger::GetStrValue
+
+  //-------------------------------------------------------------------------------------------------
+
+  const std::string & CSimFireLogger::GetStrValue( LogLevel_t level )
+  {
+    static const std::string lTrace( "trace" );
+    static const std::string lDebug( "debug" );
+    static const std::string lInfo( "info" );
+    static const std::string lWarning( "warning" );
+    static const std::string lError( "error" );
+    static const std::string lOff( "off" );
+    static const std::string lInvalidCode( "InvalidCode" );
+
+    switch( level )
+    {
+      case LogLevel_t::kTrace:   return lTrace;
+      case LogLevel_t::kDebug:   return lDebug;
+      case LogLevel_t::kInfo:    return lInfo;
+      case LogLevel_t::kWarning: return lWarning;
+      case LogLevel_t::kError:   return lError;
+      case LogLevel_t::kOff:     return lOff;
+      default:                   return lInvalidCode;
+    } // switch
+
+  } // CSimFireLogger::GetStrValue
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireLogger::Ring_t & CSimFireLogger::GetRing()
+  {
+    thread_local uint64_t tLoggerId = 0;
+    thread_local Ring_t * tRing = nullptr;
+                        // Ring of the thread in the logger it wrote to last. Only this one is kept, so
+                        // the cache does not grow with loggers created during life of the thread (a
+                        // thread returning to an older logger just gets another ring in it).
+
+    if( tLoggerId == mLoggerId )
+      return *tRing;
+
+    auto ring = std::make_unique<Ring_t>();
+    ring->slots.resize( mMask + 1 );
+    ring->head.store( 0, std::memory_order_relaxed );
+    ring->tail.store( 0, std::memory_order_relaxed );
+    ring->dropped.store( 0, std::memory_order_relaxed );
+
+    std::lock_guard lock( mRingsMutex );
+    tLoggerId = mLoggerId;
+    tRing = ring.get();
+    mRings.push_back( std::move( ring ) );
+    return *tRing;
+
+  } // CSimFireLogger::GetRing
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireLogger::WriterLoop()
+  {
+    std::unique_lock lock( mWriterMutex );
+
+    while( true )
+    {
+      mWakeUp.wait_for( lock, kWriterPeriod, [this]() {
+        return mStop || mFlushesDone < mFlushRequests || mWakeRequested.load( std::memory_order_relaxed ); } );
+                        // A wake up request of a producer may be missed (it does not take the mutex),
+                        // then the messages wait for the period
+
+      bool stop = mStop;
+      uint64_t requests = mFlushRequests;
+      mWakeRequested.store( false, std::memory_order_relaxed );
+
+      lock.unlock();
+      DrainRings();
+      lock.lock();
+
+      mFlushesDone = requests;
+      mFlushed.notify_all();
+
+      if( stop )
+        break;
+    } // while
+
+  } // CSimFireLogger::WriterLoop
+
+  //-------------------------------------------------------------------------------------------------
+
+  size_t CSimFireLogger::DrainRings()
+  {
+    uint64_t limit = mNextSeq.load( std::memory_order_acquire );
+    uint64_t expected = limit - mWritten.load( std::memory_order_relaxed );
+                        // Sequence numbers are dense (a dropped message takes none), so the pass takes
+                        // exactly the messages from the last written one up to the limit
+
+    if( 0 == expected )
+      return 0;
+
+    mDrainRings.clear();
+    {
+      std::lock_guard lock( mRingsMutex );
+      for( const auto & ring : mRings )
+        mDrainRings.emplace_back( ring.get(), 0 );
+    }
+
+    while( true )
+    {                   // A thread may have taken its sequence number but not published the message
+                        // yet, messages written after it by other threads wait until it comes (it is
+                        // a matter of a few instructions, the thread never waits for the writer then)
+      mDrainBatch.clear();
+      for( auto & [ring, end] : mDrainRings )
+      {
+        uint64_t head = ring->head.load( std::memory_order_acquire );
+        for( end = ring->tail.load( std::memory_order_relaxed ); end < head; ++end )
+        {               // Sequence numbers of a ring ascend, messages beyond the limit stay for the next pass
+          const Slot_t & slot = ring->slots[end & mMask];
+          if( limit <= slot.seq )
+            break;
+          mDrainBatch.emplace_back( slot.seq, &slot.text );
+        } // for
+      } // for
+
+      if( expected <= mDrainBatch.size() )
+        break;
+      std::this_thread::yield();
+    } // while
+
+    std::sort( mDrainBatch.begin(), mDrainBatch.end() );
+                        // Messages of different threads are interleaved in order they were written
+
+    mDrainText.clear();
+    for( const auto & message : mDrainBatch )
+      mDrainText.append( *message.second );
+
+    mOut.write( mDrainText.data(), (std::streamsize)mDrainText.size() );
+    mOut.flush();
+
+    for( const auto & [ring, end] : mDrainRings )
+      ring->tail.store( end, std::memory_order_release );
+                        // Slots are given back only when their texts are written
+
+    mWritten.fetch_add( mDrainBatch.size(), std::memory_order_relaxed );
+    return mDrainBatch.size();
+
+  } // CSimFireLogger::DrainRings
+
+} // namespace SimFire
@@ -0,0 +1,205 @@
+//****************************************************************************************************
+//! \file CSimFireLogger.h
+//! Module contains declaration of CSimFireLogger class, an asynchronous logging backend with
+//! per-thread lock-free ring buffers drained by a background writer thread.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_CSimFireLogger
+#define H_CSimFireLogger
+
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SimFireGlobals.h>
+#include <SimFireStringTools.h>
+
+#define SIMFIRE_LOG( target, level, id, ... )                                                       \
+  do {                                                                                              \
+    if constexpr( SimFire::gLogFloor <= ( level ) )                                                 \
+      if( ( target ).IsLogEnabled( level ) )                                                        \
+        ( target ).WriteLogMessage( ( level ), ( id ), SimFire::FormatStr( __VA_ARGS__ ) );         \
+  } while( false )
+  //!< Logs a message formatted by FormatStr through the target (an object with methods IsLogEnabled and
+  //!  WriteLogMessage). If the level is disabled, neither the identifier and arguments are evaluated nor
+  //!  the message is formatted; levels below gLogFloor are not compiled at all.
+
+namespace SimFire
+{
+
+  //***** CSimFireLogger *****************************************************************************
+
+  /*!  \brief Asynchronous logger. Each thread writing messages gets its own ring buffer of message
+       slots on its first message; from then on writing is lock-free (only the thread itself moves
+       the head of its ring, only the writer thread moves the tail), so logging never serializes
+       simulation workers. Slots keep capacity of their strings, so a warm ring does not allocate.
+
+       The writer thread wakes up periodically (or when a ring is half full, or on Flush), takes waiting
+       messages of all rings, orders them by global sequence number and writes them to the stream as one
+       batch with a single flush. A pass takes only messages up to the last sequence number given out
+       when it started, and waits for any of them still being put to a ring, so the whole output is
+       in order of sequence numbers, not only each batch. When a ring is full, the message is either dropped
+       (and counted) or the thread waits for the writer, according to the overflow policy. */
+  class CSimFireLogger
+  {
+
+  public:
+
+    //------------------------------------------------------------------------------------------------
+    //! @name Constructors, destructor, clonning, assign operators
+    //@{----------------------------------------------------------------------------------------------
+
+    CSimFireLogger( std::ostream & out, size_t bufferSize, LogOverflow_t overflow );
+    /*!< \brief Creates the logger and starts its writer thread.
+
+         \param[in] out        Output stream, used only by the writer thread
+         \param[in] bufferSize Number of message slots of the ring of each thread (rounded up to
+                               a power of two)
+         \param[in] overflow   What to do with a message when the ring of the thread is full */
+
+    CSimFireLogger( const CSimFireLogger & ) = delete;
+
+    CSimFireLogger & operator=( const CSimFireLogger & ) = delete;
+
+    virtual ~CSimFireLogger();
+    /*!< \brief Writes all waiting messages and joins the writer thread. */
+
+    //@}-----------------------------------------------------------------------------------------------
+    //! @name Public methods  */
+    //@{-----------------------------------------------------------------------------------------------
+
+    void Write( const std::string & id, const std::string & mssg );
+    /*!< \brief Puts the message to the ring of the calling thread (thread safe, lock-free except for
+         the first message of the thread).
+
+         \param[in] id    Identifier of the message source (module, thread, ...)
+         \param[in] mssg  Message text */
+
+    void Flush();
+    /*!< \brief Blocks until all messages written (by any thread) before the call are in the stream
+         and the stream is flushed. */
+
+    uint64_t GetWritten() const { return mWritten.load( std::memory_order_relaxed ); }
+    //!< \brief Returns number of messages written to the stream so far
+
+    uint64_t GetDropped() const;
+    //!< \brief Returns number of messages dropped so far because of full rings
+
+    static const std::string & GetStrValue( LogOverflow_t overflow );
+    /*!< \brief Returns string representation of given overflow policy.
+
+         \param[in] overflow Overflow policy
+         \return String representation of the policy */
+
+    static const std::string & GetStrValue( LogLevel_t level );
+    /*!< \brief Returns string representation of given log level (as used in settings).
+
+         \param[in] level Log level
+         \return String representation of the level */
+
+    //@}---------------------------------------------------------------------------------------------
+    //! @name Protected data
+    //@{----------------------------------------------------------------------------------------------
+
+  protected:
+
+    //! Slot of a ring, keeps its string between messages
+    struct Slot_t {
+      uint64_t seq;     //!< Global sequence number of the message
+      std::string text; //!< Formatted message including the end of line
+    };
+
+    //! Ring buffer of one thread (single producer, single consumer)
+    struct Ring_t {
+      std::vector<Slot_t> slots;
+                        //!< Message slots, size is a power of two
+      alignas( gCacheLineSize ) std::atomic<uint64_t> head;
+                        //!< Number of messages put by the producer thread
+      alignas( gCacheLineSize ) std::atomic<uint64_t> tail;
+                        //!< Number of messages taken by the writer thread
+      std::atomic<uint64_t> dropped;
+                        //!< Number of messages dropped because the ring was full
+    };
+
+    Ring_t & GetRing();
+    /*!< \brief Returns ring of the calling thread, the ring is created on the first call.
+
+         \return Ring of the calling thread */
+
+    void WriterLoop();
+    /*!< \brief Body of the writer thread, drains rings until the logger is destroyed. */
+
+    size_t DrainRings();
+    /*!< \brief Writes all waiting messages of all rings to the stream as one batch (writer thread only).
+
+         \return Number of written messages */
+
+    std::ostream & mOut;//!< Output stream
+
+    size_t mMask;       //!< Size of rings minus one (size is a power of two)
+
+    LogOverflow_t mOverflow;
+                        //!< What to do with a message when the ring is full
+
+    uint64_t mLoggerId; //!< Unique identifier of the logger, keys rings cached by threads
+
+    std::atomic<uint64_t> mNextSeq;
+                        //!< Sequence number of the next message (orders messages of different threads)
+
+    std::atomic<uint64_t> mWritten;
+                        //!< Number of messages written to the stream
+
+    mutable std::mutex mRingsMutex;
+                        //!< Guards the list of rings (taken only when a thread writes its first message
+                        //!  and by the writer thread)
+
+    std::vector<std::unique_ptr<Ring_t>> mRings;
+                        //!< Rings of all threads which wrote a message
+
+    std::atomic<bool> mWakeRequested;
+                        //!< Set by a producer whose ring is half (or completely) full
+
+    std::mutex mWriterMutex;
+                        //!< Guards the state of the writer thread below
+
+    std::condition_variable mWakeUp;
+                        //!< Wakes up the writer thread (ring half full, flush or stop request)
+
+    std::condition_variable mFlushed;
+                        //!< Signals end of a drain pass to threads waiting in Flush
+
+    uint64_t mFlushRequests;
+                        //!< Number of flush requests so far
+
+    uint64_t mFlushesDone;
+                        //!< Number of flush requests satisfied by completed drain passes
+
+    bool mStop;         //!< If true, the writer thread writes the rest of messages and ends
+
+    std::vector<std::pair<Ring_t *, uint64_t>> mDrainRings;
+                        //!< Rings drained by the actual pass and ends of their taken messages (writer thread only)
+
+    std::vector<std::pair<uint64_t, const std::string *>> mDrainBatch;
+                        //!< Sequence numbers and texts of messages of the actual pass (writer thread only)
+
+    std::string mDrainText;
+                        //!< Text of the actual pass written at once (writer thread only)
+
+    std::thread mWriter;//!< Writer thread (declared last, started when all above is ready)
+
+    //@}
+
+  }; // CSimFireLogger
+
+} // namespace SimFire
+
+#endif
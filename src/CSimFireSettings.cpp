@@ -11,6 +11,10 @@
 #include <iomanip>
 
 #include <CSimFireSettings.h>
+#include <CSimFireBatchRun.h>
+#include <CSimFireLogger.h>
+#include <CSimFireTelemetry.h>
+#include <CSimFireWorkerPool.h>
 #include <SimFireStringTools.h>
 
 namespace SimFire
@@ -42,11 +46,36 @@ namespace SimFire
      mg( 9.81 ),
      mDensity( 1.225 ),
      mdt( 0.01 ),
+     mIntegrator( IntegratorType_t::kEuler ),
+     mAbsTolerance( 1e-6 ),
+     mRelTolerance( 1e-9 ),
+     mContinuousCollisions( false ),
+     mSubTickApproach( false ),
+     mCrossCheck( false ),
+     mRecedingTermination( false ),
+     mPersistentRuns( false ),
+     mFusedKernel( false ),
+     mBatchEngine( false ),
+     mSimdLevel( SimdLevel_t::kAuto ),
+     mLogLevel( LogLevel_t::kInfo ),
      mLogInterval( 0.1 ),
+     mLogBuffer( 4096 ),
+     mLogOverflow( LogOverflow_t::kBlock ),
+     mTelemetryFile(),
+     mTelemetryFormat( TelemetryFormat_t::kCsv ),
+     mTraceFile(),
      mSeed( -1 ),
      mNumberOfThreads( 8 ),
+     mSchedule( ScheduleType_t::kDynamic ),
+     mSteadyState( false ),
+     mStopOnFirstHit( false ),
+     mEvalCache( false ),
+     mCacheTolerance( 1e-9 ),
      mRunsInGeneration( 25 ),
      mMaxGenerations( 50 ),
+     mConvergenceTolerance( 0.0 ),
+     mStagnationLimit( 0 ),
+     mDeadline( 0.0 ),
      mIniZCoef( -1 )
    {
 
@@ -121,24 +150,126 @@ namespace SimFire
        if( !IsPositive( mg ) )
          vErrors.emplace_back( "Gravitational acceleration must be positive" );
        mDensity = inCfg.GetValueDouble( "environment", "density", 0.0 );
-       if( !IsPositive( mDensity ) )
+       if( IsNegative( mDensity, 0.0 ) )
          vErrors.emplace_back( "Air density must not be negative" );
 
        mdt = inCfg.GetValueDouble( "simulation", "dt", 0.0 );
        if( !IsPositive( mdt ) )
          vErrors.emplace_back( "Time step must be positive" );
+
+       auto integratorStr = inCfg.GetValueStr( "simulation", "integrator", "euler" );
+       if( IEquals( integratorStr, "euler" ) )
+         mIntegrator = IntegratorType_t::kEuler;
+       else if( IEquals( integratorStr, "symplectic" ) )
+         mIntegrator = IntegratorType_t::kSymplecticEuler;
+       else if( IEquals( integratorStr, "verlet" ) )
+         mIntegrator = IntegratorType_t::kVelocityVerlet;
+       else if( IEquals( integratorStr, "rk4" ) )
+         mIntegrator = IntegratorType_t::kRungeKutta4;
+       else if( IEquals( integratorStr, "dopri5" ) )
+         mIntegrator = IntegratorType_t::kDormandPrince;
+       else if( IEquals( integratorStr, "analytic" ) )
+         mIntegrator = IntegratorType_t::kAnalytic;
+       else
+         vErrors.emplace_back( "Unknown integrator (expected euler, symplectic, verlet, rk4, dopri5 or analytic)" );
+       if( IntegratorType_t::kAnalytic == mIntegrator && ! InVacuum() )
+         vErrors.emplace_back( "Analytic integrator requires vacuum (zero air density)" );
+       mCrossCheck = inCfg.GetValueBool( "simulation", "crosscheck", false );
+       mAbsTolerance = inCfg.GetValueDouble( "simulation", "atol", 1e-6 );
+       if( !IsPositive( mAbsTolerance, 0.0 ) )
+         vErrors.emplace_back( "Absolute tolerance must be positive" );
+       mRelTolerance = inCfg.GetValueDouble( "simulation", "rtol", 1e-9 );
+       if( IsNegative( mRelTolerance, 0.0 ) )
+         vErrors.emplace_back( "Relative tolerance must not be negative" );
+
+       mContinuousCollisions = inCfg.GetValueBool( "simulation", "ccd", false );
+       mSubTickApproach = inCfg.GetValueBool( "simulation", "subtick", false );
+       mRecedingTermination = inCfg.GetValueBool( "simulation", "receding", false );
+       mPersistentRuns = inCfg.GetValueBool( "simulation", "persistent", false );
+       mFusedKernel = inCfg.GetValueBool( "simulation", "fused", false );
+       mBatchEngine = inCfg.GetValueBool( "simulation", "batch", false );
+
+       auto simdStr = inCfg.GetValueStr( "simulation", "simd", "auto" );
+       if( IEquals( simdStr, "auto" ) )
+         mSimdLevel = SimdLevel_t::kAuto;
+       else if( IEquals( simdStr, "scalar" ) )
+         mSimdLevel = SimdLevel_t::kScalar;
+       else if( IEquals( simdStr, "sse2" ) )
+         mSimdLevel = SimdLevel_t::kSSE2;
+       else if( IEquals( simdStr, "avx2" ) )
+         mSimdLevel = SimdLevel_t::kAVX2;
+       else
+         vErrors.emplace_back( "Unknown SIMD instruction set (expected auto, scalar, sse2 or avx2)" );
        mRunsInGeneration = (uint32_t)inCfg.GetValueInteger( "simulation", "generation", 0 );
        if( !IsPositive( mRunsInGeneration ) )
          vErrors.emplace_back( "Generation size must be positive" );
        mMaxGenerations = (uint32_t)inCfg.GetValueInteger( "simulation", "maxgens", 0 );
        if( !IsPositive( mMaxGenerations ) )
          vErrors.emplace_back( "Maximum number of generations size must be positive" );
+       mConvergenceTolerance = inCfg.GetValueDouble( "simulation", "convtol", 0.0 );
+       if( IsNegative( mConvergenceTolerance, 0.0 ) )
+         vErrors.emplace_back( "Convergence tolerance must not be negative" );
+       mStagnationLimit = (uint32_t)inCfg.GetValueUnsigned( "simulation", "stagnation", 0 );
+       mDeadline = inCfg.GetValueDouble( "simulation", "deadline", 0.0 );
+       if( IsNegative( mDeadline, 0.0 ) )
+         vErrors.emplace_back( "Deadline must not be negative" );
        mNumberOfThreads = (int32_t)inCfg.GetValueUnsigned( "simulation", "threads", 0 );
+
+       auto scheduleStr = inCfg.GetValueStr( "simulation", "schedule", "dynamic" );
+       if( IEquals( scheduleStr, "dynamic" ) )
+         mSchedule = ScheduleType_t::kDynamic;
+       else if( IEquals( scheduleStr, "static" ) )
+         mSchedule = ScheduleType_t::kStatic;
+       else if( IEquals( scheduleStr, "lpt" ) )
+         mSchedule = ScheduleType_t::kLongestFirst;
+       else
+         vErrors.emplace_back( "Unknown schedule (expected dynamic, static or lpt)" );
+
+       mSteadyState = inCfg.GetValueBool( "simulation", "steadystate", false );
+       mStopOnFirstHit = inCfg.GetValueBool( "simulation", "firsthit", false );
+       mEvalCache = inCfg.GetValueBool( "simulation", "cache", false );
+       mCacheTolerance = inCfg.GetValueDouble( "simulation", "cachetol", 1e-9 );
+       if( IsNegative( mCacheTolerance, 0.0 ) )
+         vErrors.emplace_back( "Cache tolerance must not be negative" );
+
        mSeed = (int32_t)inCfg.GetValueInteger( "simulation", "seed", -1 );
 
        mIniZCoef = inCfg.GetValueDouble( "simulation", "inizcoef", -1.0 );
 
+       auto levelStr = inCfg.GetValueStr( "logging", "level", "info" );
+       bool levelFound = false;
+       for( auto level : { LogLevel_t::kTrace, LogLevel_t::kDebug, LogLevel_t::kInfo, LogLevel_t::kWarning,
+         LogLevel_t::kError, LogLevel_t::kOff } )
+         if( IEquals( levelStr, CSimFireLogger::GetStrValue( level ) ) )
+         {
+           mLogLevel = level;
+           levelFound = true;
+         } // if
+       if( !levelFound )
+         vErrors.emplace_back( "Unknown log level (expected trace, debug, info, warning, error or off)" );
+
        mLogInterval = inCfg.GetValueDouble( "logging", "interval", 0.0 );
+       mLogBuffer = (uint32_t)inCfg.GetValueUnsigned( "logging", "buffer", 4096 );
+
+       auto overflowStr = inCfg.GetValueStr( "logging", "overflow", "block" );
+       if( IEquals( overflowStr, "block" ) )
+         mLogOverflow = LogOverflow_t::kBlock;
+       else if( IEquals( overflowStr, "drop" ) )
+         mLogOverflow = LogOverflow_t::kDrop;
+       else
+         vErrors.emplace_back( "Unknown log overflow policy (expected block or drop)" );
+
+       mTelemetryFile = inCfg.GetValueStr( "logging", "telemetry", "" );
+
+       auto telemetryFormatStr = inCfg.GetValueStr( "logging", "telemetryformat", "csv" );
+       if( IEquals( telemetryFormatStr, "csv" ) )
+         mTelemetryFormat = TelemetryFormat_t::kCsv;
+       else if( IEquals( telemetryFormatStr, "json" ) )
+         mTelemetryFormat = TelemetryFormat_t::kJson;
+       else
+         vErrors.emplace_back( "Unknown telemetry format (expected csv or json)" );
+
+       mTraceFile = inCfg.GetValueStr( "logging", "tracefile", "" );
      }
      catch( std::exception& e )
      {
@@ -194,13 +325,47 @@ namespace SimFire
      PrpLine( out ) << "Density" << mDensity << " kg/m^3" <<  std::endl << std::endl;
 
      PrpLine( out ) << "dt" << mdt << " s" << std::endl;
+     PrpLine( out ) << "Integrator" << GetStrValue( mIntegrator ) << std::endl;
+     if( IntegratorType_t::kAnalytic == mIntegrator )
+       PrpLine( out ) << "CrossCheck" << ( mCrossCheck ? "true" : "false" ) << std::endl;
+     if( IntegratorType_t::kDormandPrince == mIntegrator )
+     {
+       PrpLine( out ) << "AbsTolerance" << mAbsTolerance << std::endl;
+       PrpLine( out ) << "RelTolerance" << mRelTolerance << std::endl;
+     } // if
+     PrpLine( out ) << "CCD" << ( mContinuousCollisions ? "true" : "false" ) << std::endl;
+     PrpLine( out ) << "SubTickApproach" << ( mSubTickApproach ? "true" : "false" ) << std::endl;
+     PrpLine( out ) << "RecedingCheck" << ( mRecedingTermination ? "true" : "false" ) << std::endl;
+     PrpLine( out ) << "PersistentRuns" << ( mPersistentRuns ? "true" : "false" ) << std::endl;
+     PrpLine( out ) << "FusedKernel" << ( mFusedKernel ? "true" : "false" ) << std::endl;
+     PrpLine( out ) << "BatchEngine" << ( mBatchEngine ? "true" : "false" ) << std::endl;
+     PrpLine( out ) << "SimdLevel" << CSimFireBatchRun::GetStrValue( mSimdLevel ) << std::endl;
      PrpLine( out ) << "RunsInGeneration" << mRunsInGeneration << std::endl;
      PrpLine( out ) << "MaxGenerations" << mMaxGenerations << std::endl;
+     PrpLine( out ) << "ConvergenceTol" << mConvergenceTolerance << std::endl;
+     PrpLine( out ) << "StagnationLimit" << mStagnationLimit << std::endl;
+     PrpLine( out ) << "Deadline" << mDeadline << " s" << std::endl;
      PrpLine( out ) << "NumberOfThreads" << mNumberOfThreads << std::endl;
+     PrpLine( out ) << "Schedule" << CSimFireWorkerPool::GetStrValue( mSchedule ) << std::endl;
+     PrpLine( out ) << "SteadyState" << ( mSteadyState ? "true" : "false" ) << std::endl;
+     PrpLine( out ) << "StopOnFirstHit" << ( mStopOnFirstHit ? "true" : "false" ) << std::endl;
+     PrpLine( out ) << "EvalCache" << ( mEvalCache ? "true" : "false" ) << std::endl;
+     if( mEvalCache )
+       PrpLine( out ) << "CacheTolerance" << mCacheTolerance << std::endl;
      PrpLine( out ) << "Seed" << mSeed << std::endl;
      PrpLine( out ) << "IniZCoef" << mIniZCoef << std::endl << std::endl;
 
-     PrpLine( out ) << "LogInterval" << mLogInterval << " s" << std::endl << std::endl;
+     PrpLine( out ) << "LogLevel" << CSimFireLogger::GetStrValue( mLogLevel ) << std::endl;
+     PrpLine( out ) << "LogFloor" << CSimFireLogger::GetStrValue( gLogFloor ) << " (compiled in)" << std::endl;
+     PrpLine( out ) << "LogInterval" << mLogInterval << " s" << std::endl;
+     PrpLine( out ) << "LogBuffer" << mLogBuffer << std::endl;
+     if( 0 < mLogBuffer )
+       PrpLine( out ) << "LogOverflow" << CSimFireLogger::GetStrValue( mLogOverflow ) << std::endl;
+     PrpLine( out ) << "Telemetry" << ( mTelemetryFile.empty() ? "none" : mTelemetryFile ) << std::endl;
+     if( !mTelemetryFile.empty() )
+       PrpLine( out ) << "TelemetryFormat" << CSimFireTelemetry::GetStrValue( mTelemetryFormat ) << std::endl;
+     PrpLine( out ) << "TraceFile" << ( mTraceFile.empty() ? "none" : mTraceFile ) << std::endl;
+     out << std::endl;
 
 		 return out;
 
@@ -14,6 +14,7 @@
 #include <iostream>
 
 #include <CSimFireConfig.h>
+#include <SimFireIntegrators.h>
 
 namespace SimFire
 {
@@ -131,20 +132,95 @@ namespace SimFire
     double_t GetDt() const { return mdt; }
     //!< \brief Returns time step [s]
 
+    IntegratorType_t GetIntegrator() const { return mIntegrator; }
+    //!< \brief Returns integration method of bullet equations of motion
+
+    double_t GetAbsTolerance() const { return mAbsTolerance; }
+    //!< \brief Returns absolute tolerance of the adaptive integrator [m, m/s]
+
+    double_t GetRelTolerance() const { return mRelTolerance; }
+    //!< \brief Returns relative tolerance of the adaptive integrator [-]
+
+    bool GetContinuousCollisions() const { return mContinuousCollisions; }
+    //!< \brief Returns true if collisions are detected continuously (swept spheres along the tick)
+
+    bool GetSubTickApproach() const { return mSubTickApproach; }
+    //!< \brief Returns true if the closest approach to the target is searched also inside the ticks
+
+    bool GetCrossCheck() const { return mCrossCheck; }
+    //!< \brief Returns true if analytic solutions are verified by simulation with Euler integrator
+
+    bool GetRecedingTermination() const { return mRecedingTermination; }
+    //!< \brief Returns true if the run ends as soon as the bullet is provably receding from the target
+
+    bool GetPersistentRuns() const { return mPersistentRuns; }
+    //!< \brief Returns true if entities and buffers of a run worker are reused by its following runs
+
+    bool GetFusedKernel() const { return mFusedKernel; }
+    //!< \brief Returns true if the fused single-pass tick kernel is used instead of separate processors
+
+    bool GetBatchEngine() const { return mBatchEngine; }
+    //!< \brief Returns true if runs of one thread are simulated at once by SIMD batch engine
+
+    SimdLevel_t GetSimdLevel() const { return mSimdLevel; }
+    //!< \brief Returns instruction set requested for the batch engine (kAuto for the best available)
+
+    LogLevel_t GetLogLevel() const { return mLogLevel; }
+    //!< \brief Returns the lowest level of logged messages
+
     double_t GetLogInterval() const { return mLogInterval; }
     //!< \brief Returns time interval between entries [s]
 
+    uint32_t GetLogBuffer() const { return mLogBuffer; }
+    //!< \brief Returns number of messages buffered per thread by asynchronous logger (0 - synchronous logging)
+
+    LogOverflow_t GetLogOverflow() const { return mLogOverflow; }
+    //!< \brief Returns what asynchronous logger does with a message when the buffer of the thread is full
+
+    const std::string & GetTelemetryFile() const { return mTelemetryFile; }
+    //!< \brief Returns name of the file with telemetry of generations (empty - no telemetry)
+
+    TelemetryFormat_t GetTelemetryFormat() const { return mTelemetryFormat; }
+    //!< \brief Returns format of the file with telemetry of generations
+
+    const std::string & GetTraceFile() const { return mTraceFile; }
+    //!< \brief Returns name of the file with timeline of the simulation in Chrome trace event format (empty - no tracing)
+
     int32_t GetSeed() const { return mSeed; }
     //!< \brief Returns seed for random number generator (if needed)
 
     int32_t GetNumberOfThreads() const { return mNumberOfThreads; }
     //!< \brief Returns number of threads to be used for parallel processing
 
+    ScheduleType_t GetSchedule() const { return mSchedule; }
+    //!< \brief Returns distribution of runs of one generation among threads
+
+    bool GetSteadyState() const { return mSteadyState; }
+    //!< \brief Returns true if the genetic algorithm breeds a new run as soon as any run ends (no generations)
+
+    bool GetStopOnFirstHit() const { return mStopOnFirstHit; }
+    //!< \brief Returns true if runs still in flight are cancelled as soon as any run hits the target
+
+    bool GetEvalCache() const { return mEvalCache; }
+    //!< \brief Returns true if results of already simulated runs are reused for the same aim vectors
+
+    double_t GetCacheTolerance() const { return mCacheTolerance; }
+    //!< \brief Returns quantization step of unit aim vector for the evaluation cache (0 for exact match) [-]
+
     uint32_t GetRunsInGeneration() const { return mRunsInGeneration; }
     //!< \brief Returns number of runs in one generation (genetic algorithm)
 
     uint32_t GetMaxGenerations() const { return mMaxGenerations; }
     //!< \brief Returns maximum number of generations (genetic algorithm)
+
+    double_t GetConvergenceTolerance() const { return mConvergenceTolerance; }
+    //!< \brief Returns relative spread of Z coefficients of survivors considered converged (0 - not checked) [-]
+
+    uint32_t GetStagnationLimit() const { return mStagnationLimit; }
+    //!< \brief Returns number of generations without improvement of the best run ending the GA (0 - not checked)
+
+    double_t GetDeadline() const { return mDeadline; }
+    //!< \brief Returns wall time limit of the genetic algorithm (0 - no limit) [s]
     
     double_t GetIniZCoef() const { return mIniZCoef; }
     //!< \brief Returns initial Z velocity coefficient (used for initial generation of runs)
@@ -152,6 +228,9 @@ namespace SimFire
 
   protected:
 
+    friend class CSimFireBenchmark;
+    //!< Benchmark runs the scenario repeatedly with modified integrator and time step (on a copy)
+
     //@}----------------------------------------------------------------------------------------------
     //! @name Protected input data                                                                            
     //@{----------------------------------------------------------------------------------------------
@@ -187,19 +266,87 @@ namespace SimFire
 
     double_t mdt;       //!< Time step [s]
 
+    IntegratorType_t mIntegrator;
+                        //!< Integration method of bullet equations of motion
+
+    double_t mAbsTolerance;
+                        //!< Absolute tolerance of the adaptive integrator [m, m/s]
+
+    double_t mRelTolerance;
+                        //!< Relative tolerance of the adaptive integrator [-]
+
+    bool mContinuousCollisions;
+                        //!< If true, collisions are detected continuously (swept spheres along the tick)
+
+    bool mSubTickApproach;
+                        //!< If true, closest approach to the target is searched also inside the ticks
+
+    bool mCrossCheck;   //!< If true, analytic solutions are verified by simulation with Euler integrator
+
+    bool mRecedingTermination;
+                        //!< If true, the run ends as soon as the bullet is provably receding from the target
+
+    bool mPersistentRuns;
+                        //!< If true, entities and buffers of a run worker are reused by its following runs
+
+    bool mFusedKernel;  //!< If true, fused single-pass tick kernel is used instead of separate processors
+
+    bool mBatchEngine;  //!< If true, runs of one thread are simulated at once by SIMD batch engine
+
+    SimdLevel_t mSimdLevel;
+                        //!< Instruction set requested for the batch engine
+
+    LogLevel_t mLogLevel;
+                        //!< The lowest level of logged messages
+
     double_t mLogInterval; 
                         //!< Time interval between entries [s]
 
+    uint32_t mLogBuffer;//!< Number of messages buffered per thread by asynchronous logger (0 - synchronous)
+
+    LogOverflow_t mLogOverflow;
+                        //!< What asynchronous logger does with a message when the buffer is full
+
+    std::string mTelemetryFile;
+                        //!< Name of the file with telemetry of generations (empty - no telemetry)
+
+    TelemetryFormat_t mTelemetryFormat;
+                        //!< Format of the file with telemetry of generations
+
+    std::string mTraceFile;
+                        //!< Name of the file with timeline of the simulation (empty - no tracing)
+
     int32_t mSeed;      //!< Seed for random number generator (if needed)
 
     int32_t mNumberOfThreads;
                         //!< Number of threads to be used for parallel processing
 
+    ScheduleType_t mSchedule;
+                        //!< Distribution of runs of one generation among threads
+
+    bool mSteadyState;  //!< If true, the genetic algorithm breeds a new run as soon as any run ends
+
+    bool mStopOnFirstHit;
+                        //!< If true, runs still in flight are cancelled as soon as any run hits the target
+
+    bool mEvalCache;    //!< If true, results of already simulated runs are reused for the same aim vectors
+
+    double_t mCacheTolerance;
+                        //!< Quantization step of unit aim vector for the evaluation cache [-]
+
     uint32_t mRunsInGeneration;
                         //!< Number of runs in one generation (for genetic algorithms)
     uint32_t mMaxGenerations;
                         //!< Maximum number of generations (for genetic algorithms)
 
+    double_t mConvergenceTolerance;
+                        //!< Relative spread of Z coefficients of survivors considered converged [-]
+
+    uint32_t mStagnationLimit;
+                        //!< Number of generations without improvement of the best run ending the GA
+
+    double_t mDeadline; //!< Wall time limit of the genetic algorithm [s]
+
     double_t mIniZCoef; //!< Initial Z velocity coefficient (used for initial generation of runs)
 
     std::ostream & PrpLine( std::ostream & out );
@@ -8,8 +8,15 @@
 //****************************************************************************************************
 
 #include <ranges>
+#include <optional>
+#include <cassert>
+#include <tuple>
+#include <type_traits>
 
 #include <SimFireStringTOols.h>
+#include <SimFireIntegrators.h>
+#include <SimFireAllocCounter.h>
+#include <SimFireProfiler.h>
 #include <CSimFireSingleRun.h>
 
 namespace SimFire
@@ -59,6 +66,60 @@ namespace SimFire
     double_t Cd;        //!< Drag coefficient (ideal sphere) [-]
   };
 
+  //****** component: position at the beginning of the tick *****************************************
+
+  struct cpPrevPosition {
+    double_t X;         //!< X position (of centre of mass) at the beginning of the tick [m]
+    double_t Y;         //!< Y position (of centre of mass) at the beginning of the tick [m]
+    double_t Z;         //!< Z position (of centre of mass) at the beginning of the tick [m]
+  };
+
+  //****** geometry helpers **************************************************************************
+
+  static cpPosition ContactPoint( const cpPosition & c1, double_t r1, const cpPosition & c2, double_t r2 )
+  {                     // Touching spheres meet on the line of centres, in ratio of their radii
+    double_t k = r1 / ( r1 + r2 );
+    return cpPosition{ c1.X + k * ( c2.X - c1.X ), c1.Y + k * ( c2.Y - c1.Y ), c1.Z + k * ( c2.Z - c1.Z ) };
+  } // ContactPoint
+
+  static bool SweptSpheresTouch(
+    const cpPosition & a0, const cpPosition & a1,
+    const cpPosition & b0, const cpPosition & b1,
+    double_t radiusSum, double_t & fraction )
+  {                     // Both centres move linearly during the tick (a0 -> a1, b0 -> b1). Relative position
+                        // is d(s) = d0 + s * dd for s from <0, 1>, the first s with |d(s)| = radiusSum
+                        // is solution of quadratic equation a * s^2 + 2 * b * s + c = 0.
+    double_t d0X = a0.X - b0.X;
+    double_t d0Y = a0.Y - b0.Y;
+    double_t d0Z = a0.Z - b0.Z;
+    double_t ddX = ( a1.X - b1.X ) - d0X;
+    double_t ddY = ( a1.Y - b1.Y ) - d0Y;
+    double_t ddZ = ( a1.Z - b1.Z ) - d0Z;
+
+    double_t c = d0X * d0X + d0Y * d0Y + d0Z * d0Z - radiusSum * radiusSum;
+    if( c < 0.0 )
+    {                   // Spheres overlap already at the beginning of the tick
+      fraction = 0.0;
+      return true;
+    } // if
+
+    double_t a = ddX * ddX + ddY * ddY + ddZ * ddZ;
+    double_t b = d0X * ddX + d0Y * ddY + d0Z * ddZ;
+    if( ! ( 0.0 < a ) || 0.0 <= b )
+      return false;     // Spheres do not move relatively to each other or they move apart
+
+    double_t disc = b * b - a * c;
+    if( disc < 0.0 )
+      return false;     // Closest approach is farther than sum of radii
+
+    double_t s = ( -b - std::sqrt( disc ) ) / a;
+    if( 1.0 < s )
+      return false;     // Spheres would touch after the end of the tick
+
+    fraction = s;
+    return true;
+  } // SweptSpheresTouch
+
   //****** processor: uniform rectilinear motion *****************************************************
 
   struct procURM {
@@ -127,9 +188,7 @@ namespace SimFire
                         // and A is cross-sectional area. The drag force acts in the direction opposite
                         // to the velocity vector. The acceleration due to drag is a = Fd/m, where m
 												// is mass of the object. See https://en.wikipedia.org/wiki/Drag_equation.
-
-      if( ! IsPositive( mTDCoef ) )
-				return;         // No air resistance in vacuum
+                        // In vacuum the processor is not part of the pipeline at all.
 
       auto view = reg.view<cpVelocity, cpGeometry, cpPhysProps>();
 
@@ -150,16 +209,106 @@ namespace SimFire
 
   };
 
+  //****** processor: fixed-step integration by higher-order scheme *********************************
+
+  struct procFSI {
+
+    procFSI( IntegratorType_t scheme, double_t dt, double_t g, double_t dens ):
+      mDt( dt ),
+      mG( g ),
+      mDens( dens ),
+      mUpdate( nullptr )
+    {                   // Scheme is chosen only once, each scheme has its own compiled loop
+      switch( scheme )
+      {
+        case IntegratorType_t::kSymplecticEuler:
+          mUpdate = &procFSI::updateScheme<IntegratorType_t::kSymplecticEuler>;
+          break;
+        case IntegratorType_t::kVelocityVerlet:
+          mUpdate = &procFSI::updateScheme<IntegratorType_t::kVelocityVerlet>;
+          break;
+        case IntegratorType_t::kRungeKutta4:
+          mUpdate = &procFSI::updateScheme<IntegratorType_t::kRungeKutta4>;
+          break;
+        default:
+          mUpdate = &procFSI::updateScheme<IntegratorType_t::kEuler>;
+          break;
+      } // switch
+    }
+
+    double_t mDt;       //!< Time step [s]
+    double_t mG;        //!< Gravitational acceleration [m/s^2]
+    double_t mDens;     //!< Air density [kg/m^3]
+    void ( procFSI::*mUpdate )( entt::registry & reg );
+                        //!< Update method of the chosen scheme
+
+    void reset() {}
+
+    void update( entt::registry & reg )
+    {                   // Replaces procURM, procADRG and procDVA
+      ( this->*mUpdate )( reg );
+    } // procFSI::update
+
+    template<IntegratorType_t kScheme>
+    void updateScheme( entt::registry & reg )
+    {
+      auto view = reg.view<cpPosition, cpVelocity, const cpGeometry, const cpPhysProps>();
+
+      view.each( [this]( auto & pos, auto & v, const auto & geom, const auto & prop )
+      {
+        BallisticDerivative_t f{ mG, 0.5 * mDens * prop.Cd * geom.crossSection / prop.mass };
+        OdeState_t y{ pos.X, pos.Y, pos.Z, v.vX, v.vY, v.vZ };
+
+        FixedStep<kScheme>( f, y, mDt );
+
+        pos = cpPosition{ y[0], y[1], y[2] };
+        v = cpVelocity{ y[3], y[4], y[5] };
+      } );
+
+    } // procFSI::updateScheme
+
+  }; // procFSI
+
   //****** processor: object collision check *********************************************************
 
   struct procOCC {
 
-    void reset()
-    {}
+    //! Collision of two entities
+    struct Collision_t {
+      entt::entity first;
+                        //!< First entity of the pair
+      entt::entity second;
+                        //!< Second entity of the pair
+      double_t fraction;//!< Part of the tick elapsed when the spheres touched (1 for end-of-tick test)
+      cpPosition contact;
+                        //!< Contact point of the spheres [m]
+    };
+
+    procOCC(
+      bool sweptSpheres = false,
+      std::vector<entt::entity> && entities = {},
+      std::vector<Collision_t> && collidedPairs = {} ):
+      mSweptSpheres( sweptSpheres ),
+      mEntities( std::move( entities ) ),
+      mCollidedPairs( std::move( collidedPairs ) )
+    {                   // Buffers may be handed over from the previous run, only their capacity matters
+      mEntities.clear();
+      mCollidedPairs.clear();
+    }
+
+    bool mSweptSpheres; //!< \b true if spheres are swept along the tick segment (continuous detection)
 
-    std::vector<std::pair<entt::entity, entt::entity>> mCollidedPairs;
+    std::vector<entt::entity> mEntities;
+                        //!< Collidable entities, kept between updates so that no tick allocates memory
+
+    std::vector<Collision_t> mCollidedPairs;
                         //!< List of pairs of entities that collided in the last update.
 
+    void reset()
+    {
+      mCollidedPairs.clear();
+    }
+
     void update( entt::registry & reg )
     {
 
@@ -170,7 +319,8 @@ namespace SimFire
       // on spatial grid, distances, flight levels, something like that).
 
       auto view = reg.view<cpPosition, cpGeometry>();
-      std::vector<entt::entity> entities;
+      auto & entities = mEntities;
+      entities.clear();
 
       view.each( [&entities]( entt::entity entity, const auto & pos, const auto & geom ) 
       {                 // There is no comparison operator for view iterators (view.begin() == view.end()  
@@ -178,6 +328,10 @@ namespace SimFire
         entities.push_back( entity );
       });
 
+      if( mCollidedPairs.capacity() < entities.size() * entities.size() / 2 )
+        mCollidedPairs.reserve( entities.size() * entities.size() / 2 );
+                        // All pairs may collide at once, so the list never grows after the first tick
+
       for( size_t i = 0; i < entities.size(); ++i )
       {
         for( size_t j = i + 1; j < entities.size(); ++j ) 
@@ -186,16 +340,38 @@ namespace SimFire
           auto [pos1, geom1] = view.get<cpPosition, cpGeometry>( entities[i] );
           auto [pos2, geom2] = view.get<cpPosition, cpGeometry>( entities[j] );
 
+          auto radiusSum = geom1.radius + geom2.radius;
+
+          if( mSweptSpheres )
+          {             // Positions at the beginning of the tick, stationary bodies have none
+            auto * prev1 = reg.try_get<cpPrevPosition>( entities[i] );
+            auto * prev2 = reg.try_get<cpPrevPosition>( entities[j] );
+            cpPosition start1 = prev1 ? cpPosition{ prev1->X, prev1->Y, prev1->Z } : pos1;
+            cpPosition start2 = prev2 ? cpPosition{ prev2->X, prev2->Y, prev2->Z } : pos2;
+
+            double_t fraction = 1.0;
+            if( SweptSpheresTouch( start1, pos1, start2, pos2, radiusSum, fraction ) )
+            {           // Collision detected between entities[i] and entities[j] during the tick
+              cpPosition centre1{ start1.X + fraction * ( pos1.X - start1.X ),
+                start1.Y + fraction * ( pos1.Y - start1.Y ), start1.Z + fraction * ( pos1.Z - start1.Z ) };
+              cpPosition centre2{ start2.X + fraction * ( pos2.X - start2.X ),
+                start2.Y + fraction * ( pos2.Y - start2.Y ), start2.Z + fraction * ( pos2.Z - start2.Z ) };
+              mCollidedPairs.push_back( Collision_t{ entities[i], entities[j], fraction,
+                ContactPoint( centre1, geom1.radius, centre2, geom2.radius ) } );
+            } // if
+            continue;
+          } // if
+
           auto distX = pos1.X - pos2.X;
           auto distY = pos1.Y - pos2.Y;
           auto distZ = pos1.Z - pos2.Z;
 
           auto distSq = distX * distX + distY * distY + distZ * distZ;
-          auto radiusSum = geom1.radius + geom2.radius;
 
           if( distSq < radiusSum * radiusSum )
           {             // Collision detected between entities[i] and entities[j] (ideal spheres)
-            mCollidedPairs.emplace_back( std::make_pair( entities[i], entities[j] ) );
+            mCollidedPairs.push_back( Collision_t{ entities[i], entities[j], 1.0,
+              ContactPoint( pos1, geom1.radius, pos2, geom2.radius ) } );
           } // if
 
         } // for
@@ -205,6 +381,27 @@ namespace SimFire
 
   }; // procOCC
 
+  //****** processor: previous position store *******************************************************
+
+  struct procPPS {
+
+    void reset() {}
+
+    void update( entt::registry & reg )
+    {                   // Positions at the beginning of the tick, needed by continuous collision detection
+      auto view = reg.view<const cpPosition, cpPrevPosition>();
+
+      view.each( []( const auto & pos, auto & prev )
+      {
+        prev.X = pos.X;
+        prev.Y = pos.Y;
+        prev.Z = pos.Z;
+      } );
+
+    } // procPPS::update
+
+  }; // procPPS
+
   //****** processor: out of scene check *************************************************************
 
   struct procOCS {
@@ -259,6 +456,649 @@ namespace SimFire
 
   }; // procActCheck
 
+  //****** processor pipeline ************************************************************************
+
+  template<typename Proc_t>
+  constexpr ProfiledProc_t ProfiledProcOf()
+  {                     // Counters of a processor in profiling builds (see SimFireProfiler.h)
+    if constexpr( std::is_same_v<Proc_t, procURM> )           return ProfiledProc_t::kURM;
+    else if constexpr( std::is_same_v<Proc_t, procADRG> )     return ProfiledProc_t::kADRG;
+    else if constexpr( std::is_same_v<Proc_t, procDVA> )      return ProfiledProc_t::kDVA;
+    else if constexpr( std::is_same_v<Proc_t, procOCS> )      return ProfiledProc_t::kOCS;
+    else if constexpr( std::is_same_v<Proc_t, procActCheck> ) return ProfiledProc_t::kActCheck;
+    else if constexpr( std::is_same_v<Proc_t, procOCC> )      return ProfiledProc_t::kOCC;
+    else if constexpr( std::is_same_v<Proc_t, procPPS> )      return ProfiledProc_t::kPPS;
+    else if constexpr( std::is_same_v<Proc_t, procFSI> )      return ProfiledProc_t::kFSI;
+    else
+      static_assert( sizeof( Proc_t ) == 0, "Processor of the pipeline is not profiled" );
+  } // ProfiledProcOf
+
+  template<typename Proc_t>
+  inline void UpdateProfiled( Proc_t & proc, entt::registry & reg )
+  {                     // Timer is an empty object unless profiling is compiled in
+    [[maybe_unused]] auto timer = StartProcTimer( ProfiledProcOf<Proc_t>() );
+    proc.update( reg );
+  } // UpdateProfiled
+
+  template<typename... Procs_t>
+  struct procPipeline {
+
+    procPipeline( Procs_t &... procs ):
+      mProcs( procs... )
+    {}
+
+    std::tuple<Procs_t &...> mProcs;
+                        //!< Processors in order of their evaluation (owned by the caller)
+
+    void reset() {}
+
+    void update( entt::registry & reg )
+    {                   // Sequence of processors is fixed at compile time, each feature combination
+                        // has its own instantiation, so there are no per-tick checks of disabled features
+                        // and all calls can be inlined.
+      std::apply( [&reg]( auto &... proc )
+      {
+        ( ( proc.reset(), UpdateProfiled( proc, reg ) ), ... );
+      }, mProcs );
+
+    } // procPipeline::update
+
+  }; // procPipeline
+
+  //****** processor: closest approach tracking ******************************************************
+
+  struct procCAT {
+
+    procCAT(
+      CSimFireSingleRunParams & runParams,
+      const cpPosition & targetPos,
+      const cpPosition & nVectNear,
+      double_t dConstNear,
+      bool referenceValueNearNegative,
+      bool subTick = false ):
+      mRunParams( runParams ),
+      mTargetPos( targetPos ),
+      mNVectNear( nVectNear ),
+      mDConstNear( dConstNear ),
+      mReferenceValueNearNegative( referenceValueNearNegative ),
+      mSubTick( subTick ),
+      mDistSq( 0.0 ),
+      mPrevPos{ 0.0, 0.0, 0.0 },
+      mPrevV{ 0.0, 0.0, 0.0 },
+      mPrevTime( 0.0 ),
+      mHasPrev( false )
+    {}
+
+    CSimFireSingleRunParams & mRunParams;
+                        //!< Run parameters, minimal distance and flags are stored here
+    cpPosition mTargetPos;
+                        //!< Position of the target [m]
+    cpPosition mNVectNear;
+                        //!< Half-space plane normal vector (see CSimFireSingleRun::Run)
+    double_t mDConstNear;
+                        //!< Half-space plane constant
+    bool mReferenceValueNearNegative;
+                        //!< Sign of the half-space plane equation at the shooter position
+    bool mSubTick;      //!< If true, minimal distance is searched also inside the tick segments
+    double_t mDistSq;   //!< Squared distance of the bullet to the target after the last update [m^2]
+
+    cpPosition mPrevPos;//!< Bullet position in the previous update (sub-tick search only)
+    cpVelocity mPrevV;  //!< Bullet velocity in the previous update (sub-tick search only)
+    double_t mPrevTime; //!< Time of the previous update [s] (sub-tick search only)
+    bool mHasPrev;      //!< True if the previous update is available
+
+    void reset() {}
+
+    void start( const cpPosition & bulletPos, const cpVelocity & bulletV, double_t actSimTime )
+    {                   // Initial state of the bullet is the beginning of the first tick segment
+      mPrevPos = bulletPos;
+      mPrevV = bulletV;
+      mPrevTime = actSimTime;
+      mHasPrev = true;
+    } // procCAT::start
+
+    void update( const cpPosition & bulletPos, const cpVelocity & bulletV, double_t actSimTime )
+    {
+      double_t distX = bulletPos.X - mTargetPos.X;
+      double_t distY = bulletPos.Y - mTargetPos.Y;
+      double_t distZ = bulletPos.Z - mTargetPos.Z;
+      mDistSq = distX * distX + distY * distY + distZ * distZ;
+
+      if( mSubTick && mHasPrev )
+      {                 // Between two updates the bullet moves along the segment from the previous
+                        // position to the current one. If it approaches the target at the beginning
+                        // of the segment and recedes at its end, the true minimum lies inside the
+                        // segment and it is found analytically (projection of the target onto it).
+        double_t segX = bulletPos.X - mPrevPos.X;
+        double_t segY = bulletPos.Y - mPrevPos.Y;
+        double_t segZ = bulletPos.Z - mPrevPos.Z;
+        double_t segSq = segX * segX + segY * segY + segZ * segZ;
+        double_t rateEnd = distX * segX + distY * segY + distZ * segZ;
+        double_t rateBegin = rateEnd - segSq;
+
+        if( rateBegin < 0.0 && rateEnd > 0.0 )
+        {
+          double_t fraction = -rateBegin / segSq;
+          cpPosition minPos{
+            mPrevPos.X + fraction * segX,
+            mPrevPos.Y + fraction * segY,
+            mPrevPos.Z + fraction * segZ };
+          cpVelocity minV{
+            mPrevV.vX + fraction * ( bulletV.vX - mPrevV.vX ),
+            mPrevV.vY + fraction * ( bulletV.vY - mPrevV.vY ),
+            mPrevV.vZ + fraction * ( bulletV.vZ - mPrevV.vZ ) };
+
+          double_t minX = minPos.X - mTargetPos.X;
+          double_t minY = minPos.Y - mTargetPos.Y;
+          double_t minZ = minPos.Z - mTargetPos.Z;
+          double_t minSq = minX * minX + minY * minY + minZ * minZ;
+
+          if( minSq < mRunParams.mMinDTgtSq )
+            store( minPos, minV, mPrevTime + fraction * ( actSimTime - mPrevTime ), minSq );
+        } // if
+
+        mPrevPos = bulletPos;
+        mPrevV = bulletV;
+        mPrevTime = actSimTime;
+      } // if
+
+      if( mDistSq < mRunParams.mMinDTgtSq )
+        store( bulletPos, bulletV, actSimTime, mDistSq );
+
+    } // procCAT::update
+
+    void store( const cpPosition & bulletPos, const cpVelocity & bulletV, double_t actSimTime, double_t distSq )
+    {                   // New minimal distance of the bullet to the target found. It must
+                        // be stored and short/overshot status of the bullet must be determined.
+
+      mRunParams.mMinDTgtSq = distSq;
+      mRunParams.mMinTime = actSimTime;
+                        // New minimal distance of the bullet and the time of the event is stored.
+
+      mRunParams.mRaising = ( bulletV.vZ >= 0.0 );
+                        // Bullet is rising if its vertical velocity component is positive.
+
+      mRunParams.mBelow = ( bulletPos.Z < mTargetPos.Z );
+                        // Bullet is below the target if its Z coordinate is lower than the target Z coordinate.
+
+      mRunParams.mNearHalfPlane = IsNearHalfPlane( bulletPos );
+                        // Bullet is in the same half-plane as the shooter if the value of the half-space
+                        // plane equation at the bullet position has the same sign as the reference value.
+
+    } // procCAT::store
+
+    bool IsNearHalfPlane( const cpPosition & pos ) const
+    {
+      double bRefVal = mNVectNear.X * pos.X + mNVectNear.Y * pos.Y + mNVectNear.Z * pos.Z + mDConstNear;
+      return ( mReferenceValueNearNegative ? ( bRefVal < 0.0 ) : ( bRefVal > 0.0 ) );
+    } // procCAT::IsNearHalfPlane
+
+  }; // procCAT
+
+  //****** stationary colliders snapshot *************************************************************
+
+  using StaticColliders_t = std::vector<std::pair<cpPosition, double_t>>;
+  //!< Position and radius of stationary collidable bodies
+
+  static void PrepareStaticColliders( entt::registry & reg, StaticColliders_t & colliders, bool & anyActive, bool & anyCollision )
+  {                     // Stationary bodies never change, so out-of-scene and mutual collision checks
+                        // (procOCS, procOCC) are evaluated for them only once per run.
+
+    auto view = reg.view<cpId, cpPosition, cpGeometry>( entt::exclude<cpVelocity> );
+    colliders.clear();
+
+    view.each( [&]( auto & id, const auto & pos, const auto & geom )
+    {
+      if( id.active && pos.Z <= 0.0 )
+        id.active = false;
+      if( id.active )
+        anyActive = true;
+
+      for( auto & other : colliders )
+      {
+        auto distX = pos.X - other.first.X;
+        auto distY = pos.Y - other.first.Y;
+        auto distZ = pos.Z - other.first.Z;
+        auto radiusSum = geom.radius + other.second;
+        if( distX * distX + distY * distY + distZ * distZ < radiusSum * radiusSum )
+          anyCollision = true;
+      } // for
+
+      colliders.emplace_back( pos, geom.radius );
+    } );
+
+  } // PrepareStaticColliders
+
+  //****** processor: fused single-pass tick *********************************************************
+
+  struct procFused {
+
+    using MovingGroup_t = decltype( std::declval<entt::registry &>().group<
+      cpId, cpPosition, cpVelocity, cpGeometry, cpPhysProps>() );
+                        //!< Full-owning group of moving bodies. EnTT keeps all five component arrays
+                        //!  packed and in the same order, so the tick is a linear walk over memory.
+
+    procFused( entt::registry & reg, double_t dt, double_t g, double_t dens, entt::entity tracked, procCAT & cat,
+      StaticColliders_t && staticColliders = {} ):
+      mGroup( reg.group<cpId, cpPosition, cpVelocity, cpGeometry, cpPhysProps>() ),
+      mDt( dt ),
+      mDtg( dt * g ),
+      mTDCoef( dt * 0.5 * dens ),
+      mTracked( tracked ),
+      mCAT( cat ),
+      mStaticColliders( std::move( staticColliders ) ),
+      mStaticActive( false ),
+      mStaticCollision( false ),
+      mAnythingActive( false ),
+      mCollisionDetected( false ),
+      mContactPoint{ 0.0, 0.0, 0.0 }
+    {
+      PrepareStaticColliders( reg, mStaticColliders, mStaticActive, mStaticCollision );
+    }
+
+    MovingGroup_t mGroup;
+                        //!< Moving bodies (entities with velocity and physical properties)
+    double_t mDt;       //!< Time step [s] (see procURM)
+    double_t mDtg;      //!< Time step * Gravitational acceleration (see procDVA)
+    double_t mTDCoef;   //!< Time step * ( 1/2 * Air density ) (see procADRG)
+    entt::entity mTracked;
+                        //!< Entity whose closest approach to the target is tracked (bullet)
+    procCAT & mCAT;     //!< Closest approach tracker for the tracked entity
+
+    StaticColliders_t mStaticColliders;
+                        //!< Position and radius of stationary collidable bodies (snapshot, they do not move)
+    bool mStaticActive; //!< \b true if any stationary body is active
+    bool mStaticCollision;
+                        //!< \b true if two stationary bodies overlap (constant for the whole run)
+
+    bool mAnythingActive;
+                        //!< The simulation should continue if at least one entity is active (true here).
+    bool mCollisionDetected;
+                        //!< Collision of two bodies detected in the last update
+    cpPosition mContactPoint;
+                        //!< Contact point of the last detected collision [m]
+
+    void reset()
+    {
+      mAnythingActive = mStaticActive;
+      mCollisionDetected = mStaticCollision;
+    }
+
+    template<bool kDrag>
+    void update( double_t actSimTime )
+    {                   // Steps are the same (and in the same order) as in the separate processors
+                        // procURM, procADRG, procDVA, procOCS, procActCheck and procOCC, results are
+                        // therefore bit-identical to the reference pipeline. Drag is left out at compile
+                        // time in vacuum.
+
+      mGroup.each( [&]( auto entity, auto & id, auto & pos, auto & v, const auto & geom, const auto & prop )
+      {
+        pos.X += v.vX * mDt;
+        pos.Y += v.vY * mDt;
+        pos.Z += v.vZ * mDt;
+
+        if constexpr( kDrag )
+        {
+          double_t actV = v.vX * v.vX + v.vY * v.vY + v.vZ * v.vZ;
+          double_t deltaV = mTDCoef * prop.Cd * geom.crossSection * actV / prop.mass;
+          actV = std::sqrt( actV );
+
+          double_t commonCoef = ( actV - deltaV ) / actV;
+
+          v.vX *= commonCoef;
+          v.vY *= commonCoef;
+          v.vZ *= commonCoef;
+        } // if
+
+        v.vZ -= mDtg;
+
+        if( id.active && pos.Z <= 0.0 )
+          id.active = false;
+        if( id.active )
+          mAnythingActive = true;
+
+        for( auto & other : mStaticColliders )
+        {
+          auto distX = pos.X - other.first.X;
+          auto distY = pos.Y - other.first.Y;
+          auto distZ = pos.Z - other.first.Z;
+          auto radiusSum = geom.radius + other.second;
+          if( distX * distX + distY * distY + distZ * distZ < radiusSum * radiusSum )
+          {
+            mCollisionDetected = true;
+            mContactPoint = ContactPoint( pos, geom.radius, other.first, other.second );
+          } // if
+        } // for
+
+        if( entity == mTracked )
+          mCAT.update( pos, v, actSimTime );
+      } );
+
+      if( 1 < mGroup.size() )
+      {                 // Collisions among moving bodies can be checked only after all of them moved
+        for( size_t i = 0; i < mGroup.size(); ++i )
+        {
+          for( size_t j = i + 1; j < mGroup.size(); ++j )
+          {
+            const auto & [pos1, geom1] = mGroup.get<cpPosition, cpGeometry>( mGroup[i] );
+            const auto & [pos2, geom2] = mGroup.get<cpPosition, cpGeometry>( mGroup[j] );
+
+            auto distX = pos1.X - pos2.X;
+            auto distY = pos1.Y - pos2.Y;
+            auto distZ = pos1.Z - pos2.Z;
+            auto radiusSum = geom1.radius + geom2.radius;
+            if( distX * distX + distY * distY + distZ * distZ < radiusSum * radiusSum )
+            {
+              mCollisionDetected = true;
+              mContactPoint = ContactPoint( pos1, geom1.radius, pos2, geom2.radius );
+            } // if
+          } // for
+        } // for
+      } // if
+
+    } // procFused::update
+
+  }; // procFused
+
+  //****** processor: adaptive Dormand-Prince integration ********************************************
+
+  struct procDOPRI {
+
+    //! Integration state of one moving body
+    struct Body_t {
+      entt::entity entity;
+                        //!< Entity of the body
+      BallisticDerivative_t f;
+                        //!< Right-hand side of equations of motion of the body
+      OdeState_t y;     //!< State at the beginning of the step
+      OdeState_t k;     //!< Derivative at the beginning of the step
+      OdeState_t y1;    //!< State at the end of the step
+      OdeState_t k1;    //!< Derivative at the end of the step
+      DormandPrinceDense_t dense;
+                        //!< Dense output of the last step
+      double_t landTheta;
+                        //!< Relative time of ground crossing in the last step (above 1 if none)
+    };
+
+    procDOPRI( entt::registry & reg, double_t h0, double_t g, double_t dens, double_t atol, double_t rtol,
+      entt::entity tracked, procCAT & cat, StaticColliders_t && staticColliders = {}, std::vector<Body_t> && bodies = {} ):
+      mReg( reg ),
+      mBodies( std::move( bodies ) ),
+      mStaticColliders( std::move( staticColliders ) ),
+      mH( h0 ),
+      mAtol( atol ),
+      mRtol( rtol ),
+      mTracked( tracked ),
+      mCAT( cat ),
+      mStaticActive( false ),
+      mStaticCollision( false ),
+      mAnythingActive( false ),
+      mCollisionDetected( false ),
+      mStepFailed( false ),
+      mImpactTime( 0.0 ),
+      mContactPoint{ 0.0, 0.0, 0.0 },
+      mRejectedSteps( 0 ),
+      mMinStep( 0.0 ),
+      mMaxStep( 0.0 )
+    {
+      PrepareStaticColliders( reg, mStaticColliders, mStaticActive, mStaticCollision );
+
+      mBodies.clear();  // Buffer may be handed over from the previous run
+      auto view = reg.view<cpPosition, cpVelocity, cpGeometry, cpPhysProps>();
+
+      view.each( [&]( auto entity, const auto & pos, const auto & v, const auto & geom, const auto & prop )
+      {
+        Body_t body;
+        body.entity = entity;
+        body.f = BallisticDerivative_t{ g, 0.5 * dens * prop.Cd * geom.crossSection / prop.mass };
+        body.y = { pos.X, pos.Y, pos.Z, v.vX, v.vY, v.vZ };
+        body.f( body.y, body.k );
+        mBodies.push_back( body );
+      } );
+    }
+
+    entt::registry & mReg;
+                        //!< Registry with simulated entities
+    std::vector<Body_t> mBodies;
+                        //!< Moving bodies (entities with velocity and physical properties)
+    StaticColliders_t mStaticColliders;
+                        //!< Position and radius of stationary collidable bodies (snapshot, they do not move)
+
+    double_t mH;        //!< Length of the next trial step [s]
+    double_t mAtol;     //!< Absolute tolerance
+    double_t mRtol;     //!< Relative tolerance
+    entt::entity mTracked;
+                        //!< Entity whose closest approach to the target is tracked (bullet)
+    procCAT & mCAT;     //!< Closest approach tracker for the tracked entity
+
+    bool mStaticActive; //!< \b true if any stationary body is active
+    bool mStaticCollision;
+                        //!< \b true if two stationary bodies overlap (constant for the whole run)
+
+    bool mAnythingActive;
+                        //!< The simulation should continue if at least one entity is active (true here).
+    bool mCollisionDetected;
+                        //!< Collision of two bodies detected in the last update
+    bool mStepFailed;   //!< Step size fell below resolution of the time axis, tolerances cannot be met
+    double_t mImpactTime;
+                        //!< Time of the last detected collision [s]
+    cpPosition mContactPoint;
+                        //!< Contact point of the last detected collision [m]
+
+    uint64_t mRejectedSteps;
+                        //!< Number of rejected trial steps
+    double_t mMinStep;  //!< Shortest accepted (full) step [s]
+    double_t mMaxStep;  //!< Longest accepted (full) step [s]
+
+    void reset()
+    {
+      mAnythingActive = mStaticActive;
+      mCollisionDetected = mStaticCollision;
+    }
+
+    static double_t approachRate( const DormandPrinceDense_t & dense, const cpPosition & centre, double_t theta )
+    {                   // Derivative of squared distance to given point (divided by 2) at relative time theta,
+                        // it changes sign from minus to plus in the point of the closest approach.
+      OdeState_t y;
+      dense.Evaluate( theta, y );
+      return ( y[0] - centre.X ) * y[3] + ( y[1] - centre.Y ) * y[4] + ( y[2] - centre.Z ) * y[5];
+    } // procDOPRI::approachRate
+
+    static double_t distanceSq( const DormandPrinceDense_t & dense, const cpPosition & centre, double_t theta )
+    {
+      OdeState_t y;
+      dense.Evaluate( theta, y );
+      return ( y[0] - centre.X ) * ( y[0] - centre.X ) + ( y[1] - centre.Y ) * ( y[1] - centre.Y ) +
+             ( y[2] - centre.Z ) * ( y[2] - centre.Z );
+    } // procDOPRI::distanceSq
+
+    static double_t closestApproach( const DormandPrinceDense_t & dense, const cpPosition & centre, double_t thetaEnd )
+    {                   // Relative time of the closest approach to given point within <0, thetaEnd>
+      if( 0.0 <= approachRate( dense, centre, 0.0 ) )
+        return 0.0;
+      if( approachRate( dense, centre, thetaEnd ) < 0.0 )
+        return thetaEnd;
+      return FindRoot( [&]( double_t theta ) { return approachRate( dense, centre, theta ); }, 0.0, thetaEnd );
+    } // procDOPRI::closestApproach
+
+    void update( double_t & actSimTime )
+    {                   // One accepted step of common length for all moving bodies. The step is shortened
+                        // to the first event (ground crossing or contact with a stationary body), which is
+                        // located in dense output, so the run ends exactly at the time of the event.
+
+      //------ Trial steps until the error is acceptable -------------------------------------------
+
+      double_t h = mH;
+      double_t err = 0.0;
+      bool rejected = false;
+
+      for( ;; )
+      {
+        err = 0.0;
+        for( auto & body : mBodies )
+        {
+          body.dense.t0 = actSimTime;
+          err = std::max( err, DormandPrinceStep( body.f, body.y, body.k, h, mAtol, mRtol, body.y1, body.k1, &body.dense ) );
+        } // for
+
+        if( err <= 1.0 )
+          break;
+
+        ++mRejectedSteps;
+        rejected = true;
+        h *= std::max( 0.2, 0.9 * std::pow( err, -0.2 ) );
+        if( h <= gAlmostZero * ( 1.0 + actSimTime ) )
+        {
+          mStepFailed = true;
+          return;
+        } // if
+      } // for
+
+      double_t fac = ( 0.0 < err ) ? std::min( 10.0, std::max( 0.2, 0.9 * std::pow( err, -0.2 ) ) ) : 10.0;
+      mH = h * ( rejected ? std::min( 1.0, fac ) : fac );
+                        // Step size control: next step is chosen so that the expected error is slightly
+                        // below tolerance, growth is limited (and not allowed after a rejection).
+
+      //------ Events inside the step --------------------------------------------------------------
+
+      double_t thetaEnd = 1.0;
+      bool collision = false;
+
+      for( auto & body : mBodies )
+      {
+        body.landTheta = 2.0;
+        if( mReg.get<cpId>( body.entity ).active && body.y1[2] <= 0.0 )
+        {
+          body.landTheta = FindRoot( [&]( double_t theta )
+            {
+              OdeState_t y;
+              body.dense.Evaluate( theta, y );
+              return -y[2];
+            }, 0.0, 1.0 );
+          thetaEnd = std::min( thetaEnd, body.landTheta );
+        } // if
+      } // for
+
+      for( auto & body : mBodies )
+      {
+        double_t radius = mReg.get<cpGeometry>( body.entity ).radius;
+        for( auto & other : mStaticColliders )
+        {
+          double_t radiusSumSq = ( radius + other.second ) * ( radius + other.second );
+          double_t thetaMin = closestApproach( body.dense, other.first, thetaEnd );
+          if( radiusSumSq <= distanceSq( body.dense, other.first, thetaMin ) )
+            continue;   // Bodies do not touch in this step
+
+          double_t thetaHit = 0.0;
+          if( radiusSumSq <= distanceSq( body.dense, other.first, 0.0 ) )
+            thetaHit = FindRoot( [&]( double_t theta )
+              {
+                return radiusSumSq - distanceSq( body.dense, other.first, theta );
+              }, 0.0, thetaMin );
+
+          if( thetaHit <= thetaEnd )
+          {             // The earliest contact so far
+            OdeState_t y;
+            body.dense.Evaluate( thetaHit, y );
+            mImpactTime = actSimTime + thetaHit * h;
+            mContactPoint = ContactPoint( cpPosition{ y[0], y[1], y[2] }, radius, other.first, other.second );
+            thetaEnd = thetaHit;
+          } // if
+          collision = true;
+        } // for
+      } // for
+
+      //------ Closest approach of the tracked body ------------------------------------------------
+
+      for( auto & body : mBodies )
+      {
+        if( thetaEnd < 1.0 )
+        {               // Step is shortened to the first event
+          body.dense.Evaluate( thetaEnd, body.y1 );
+          body.f( body.y1, body.k1 );
+        } // if
+
+        if( body.entity != mTracked )
+          continue;
+
+        double_t thetaMin = closestApproach( body.dense, mCAT.mTargetPos, thetaEnd );
+        if( thetaMin < thetaEnd )
+        {               // Closest approach lies inside the step
+          OdeState_t y;
+          body.dense.Evaluate( thetaMin, y );
+          mCAT.update( cpPosition{ y[0], y[1], y[2] }, cpVelocity{ y[3], y[4], y[5] }, actSimTime + thetaMin * h );
+        } // if
+
+        mCAT.update( cpPosition{ body.y1[0], body.y1[1], body.y1[2] },
+          cpVelocity{ body.y1[3], body.y1[4], body.y1[5] }, actSimTime + thetaEnd * h );
+      } // for
+
+      //------ Step completion ---------------------------------------------------------------------
+
+      if( thetaEnd < 1.0 )
+        actSimTime += thetaEnd * h;
+      else
+      {                 // Shortened last steps are not included into statistics
+        actSimTime += h;
+        mMinStep = ( 0.0 < mMinStep ) ? std::min( mMinStep, h ) : h;
+        mMaxStep = std::max( mMaxStep, h );
+      } // else
+
+      for( auto & body : mBodies )
+      {
+        auto [id, pos, v] = mReg.get<cpId, cpPosition, cpVelocity>( body.entity );
+
+        body.y = body.y1;
+        body.k = body.k1;
+        pos = cpPosition{ body.y[0], body.y[1], body.y[2] };
+        v = cpVelocity{ body.y[3], body.y[4], body.y[5] };
+
+        if( id.active && body.landTheta <= thetaEnd )
+          id.active = false;
+        if( id.active )
+          mAnythingActive = true;
+      } // for
+
+      if( collision )
+        mCollisionDetected = true;
+
+      for( size_t i = 0; i < mBodies.size(); ++i )
+      {                 // Collisions among moving bodies are checked only at the end of the step
+        for( size_t j = i + 1; j < mBodies.size(); ++j )
+        {
+          auto distX = mBodies[i].y[0] - mBodies[j].y[0];
+          auto distY = mBodies[i].y[1] - mBodies[j].y[1];
+          auto distZ = mBodies[i].y[2] - mBodies[j].y[2];
+          auto radiusSum = mReg.get<cpGeometry>( mBodies[i].entity ).radius + mReg.get<cpGeometry>( mBodies[j].entity ).radius;
+          if( distX * distX + distY * distY + distZ * distZ < radiusSum * radiusSum )
+          {
+            mCollisionDetected = true;
+            mImpactTime = actSimTime;
+            mContactPoint = ContactPoint( cpPosition{ mBodies[i].y[0], mBodies[i].y[1], mBodies[i].y[2] },
+              mReg.get<cpGeometry>( mBodies[i].entity ).radius,
+              cpPosition{ mBodies[j].y[0], mBodies[j].y[1], mBodies[j].y[2] },
+              mReg.get<cpGeometry>( mBodies[j].entity ).radius );
+          } // if
+        } // for
+      } // for
+
+    } // procDOPRI::update
+
+  }; // procDOPRI
+
+  //****** buffers kept between runs *****************************************************************
+
+  struct CSimFireSingleRun::RunBuffers_t {
+    std::vector<entt::entity> entities;
+                        //!< Collidable entities (procOCC)
+    std::vector<procOCC::Collision_t> collisions;
+                        //!< Collisions found in one tick (procOCC)
+    StaticColliders_t staticColliders;
+                        //!< Stationary collidable bodies (procFused, procDOPRI)
+    std::vector<procDOPRI::Body_t> bodies;
+                        //!< Moving bodies (procDOPRI)
+  };
+
   //****** CCSimFireSingleRun ************************************************************************
 
   CSimFireSingleRun::CSimFireSingleRun(
@@ -267,8 +1107,15 @@ namespace SimFire
     mSettings( settings ),
     mLogCallback( fnCall ),
 		mExportCallback(nullptr),
-    mRunId(),
-    mEnTTRegistry()
+    mCancelToken( nullptr ),
+    mIntegrator( settings.GetIntegrator() ),
+    mEnTTRegistry(),
+    mBuffers( std::make_unique<RunBuffers_t>() ),
+    mBullet( entt::null ),
+    mTarget( entt::null ),
+    mWarmedUp( false ),
+    mRunAllocations( 0 ),
+    mTickAllocations( 0 )
   {} 
 
 
@@ -278,25 +1125,53 @@ namespace SimFire
 
   //-------------------------------------------------------------------------------------------------
 
+  double_t CSimFireSingleRun::EstimateFlightTime( const CSimFireSettings & settings, const CSimFireSingleRunParams & runParams )
+  {
+    double_t div = std::sqrt(
+      runParams.mVelocityXCoef * runParams.mVelocityXCoef +
+      runParams.mVelocityYCoef * runParams.mVelocityYCoef +
+      runParams.mVelocityZCoef * runParams.mVelocityZCoef );
+    if( IsZero( div ) )
+      return 0.0;       // Such run ends immediately with an error
+
+    double_t velCoef = settings.GetVelocity() / div;
+    return VacuumGroundTime( OdeState_t{ settings.GetGunX(), settings.GetGunY(), settings.GetGunZ(),
+      runParams.mVelocityXCoef * velCoef, runParams.mVelocityYCoef * velCoef, runParams.mVelocityZCoef * velCoef },
+      settings.GetG() );
+
+  } // CSimFireSingleRun::EstimateFlightTime
+
+  //-------------------------------------------------------------------------------------------------
+
   int CSimFireSingleRun::Run( CSimFireSingleRunParams & runParams )
   {
-    mRunId = runParams.mRunIdentifier;
+    bool persistent = mSettings.GetPersistentRuns();
+    uint64_t runAllocations = GetAllocationCount();
+    mTickAllocations = 0;
 
-    mEnTTRegistry.clear();
-    // Setup from previous run, if any, is cleared
+    if( ! persistent || ! mEnTTRegistry.valid( mBullet ) || ! mEnTTRegistry.valid( mTarget ) )
+    {
+      mEnTTRegistry.clear();
+      // Setup from previous run, if any, is cleared
+
+      mBullet = mEnTTRegistry.create();
+      mTarget = mEnTTRegistry.create();
+    } // if
+                        // In persistent mode entities of the previous run are kept and values of their
+                        // components are reset in place, so component storage is never reallocated.
 
     //------ Bullet entity creation ----------------------------------------------------------------
 
-    const auto bullet = mEnTTRegistry.create();
+    const auto bullet = mBullet;
 
-    mEnTTRegistry.emplace<cpId>(
+    mEnTTRegistry.emplace_or_replace<cpId>(
       bullet,
       1ul,
       mBulletIdString,
       true );           // Bullet is active at the beginning of the simulation. As we have single bullet in the
                         // simulation, its index is for now hardcoded as 1.
 
-    mEnTTRegistry.emplace<cpPosition>(
+    mEnTTRegistry.emplace_or_replace<cpPosition>(
       bullet,
       mSettings.GetGunX(),
       mSettings.GetGunY(),
@@ -309,13 +1184,13 @@ namespace SimFire
       runParams.mVelocityZCoef * runParams.mVelocityZCoef );
     if( IsZero( div ) )
     {
-      if( mLogCallback )
-        mLogCallback( mRunId, "Zero velocity direction coefficients given, cannot proceed." );
+      SIMFIRE_LOG( *this, LogLevel_t::kWarning, runParams.GetRunIdentifier(),
+        "Zero velocity direction coefficients given, cannot proceed." );
       return -1;
     } // if
 
     double velCoef = mSettings.GetVelocity() / div;
-    mEnTTRegistry.emplace<cpVelocity>(
+    mEnTTRegistry.emplace_or_replace<cpVelocity>(
       bullet,
       runParams.mVelocityXCoef * velCoef,
       runParams.mVelocityYCoef * velCoef,
@@ -323,25 +1198,34 @@ namespace SimFire
                         // Size of muzzle velocity is given by user setup, its direction, however, 
                         // is given by run parameters (we are looking for right angle to hit the target)
 
-    mEnTTRegistry.emplace<cpGeometry>(
+    mEnTTRegistry.emplace_or_replace<cpGeometry>(
       bullet,
       mSettings.GetBulletSize(),
       gPI * mSettings.GetBulletSize() * mSettings.GetBulletSize() );
                         // Proximity of the bullet and target is given by distance of centres.
 												// Atmospheric drag depends on cross-sectional area of the bullet.
 
-    mEnTTRegistry.emplace<cpPhysProps>(
+    mEnTTRegistry.emplace_or_replace<cpPhysProps>(
       bullet,
       mSettings.GetMass(),
       mSettings.GetCd() );
                         // Mass and drag coefficient are given by user setup
 
+    bool sweptSpheres = mSettings.GetContinuousCollisions();
+    if( sweptSpheres )
+      mEnTTRegistry.emplace_or_replace<cpPrevPosition>(
+        bullet,
+        mSettings.GetGunX(),
+        mSettings.GetGunY(),
+        mSettings.GetGunZ() );
+                        // Continuous collision detection needs position at the beginning of each tick
+
 
 //------ Target entity creation ----------------------------------------------------------------
 
-    const auto target = mEnTTRegistry.create();
+    const auto target = mTarget;
 
-    mEnTTRegistry.emplace<cpId>(
+    mEnTTRegistry.emplace_or_replace<cpId>(
       target,
       1000ul,
       mTargetIdString,
@@ -349,14 +1233,14 @@ namespace SimFire
                         // significant for continuing the simulation. Because we have target bullet in 
                         // the simulation, its index is hardcoded as 1000.
 
-    mEnTTRegistry.emplace<cpPosition>(
+    mEnTTRegistry.emplace_or_replace<cpPosition>(
       target,
       mSettings.GetTgtX(),
       mSettings.GetTgtY(),
       mSettings.GetTgtZ() );
                         // Target position is given by user setup
 
-    mEnTTRegistry.emplace<cpGeometry>(
+    mEnTTRegistry.emplace_or_replace<cpGeometry>(
       target,
       mSettings.GetTgtSize() );
                         // Proximity of the bullet and target is given by distance of centres.
@@ -367,12 +1251,17 @@ namespace SimFire
     bool collisionDetected = false;
                         // Collision of bullet and target detected
 
+    bool cancelled = false;
+                        // Run was cancelled through the token (see SetCancelToken)
+
 //------ Main simulation loop --------------------------------------------------------------------
 
     procURM uniformRectilinearMotionProcessor( mSettings.GetDt() );
     procDVA deltaVelocityAccelerationProcessor( mSettings.GetDt(), mSettings.GetG() );
 		procADRG deltaVelocityDragProcessor(mSettings.GetDt(), mSettings.GetDensity() );
-    procOCC objectCollisionCheckProcessor;
+    procOCC objectCollisionCheckProcessor( sweptSpheres, std::move( mBuffers->entities ),
+      std::move( mBuffers->collisions ) );
+    procPPS prevPositionProcessor;
     procOCS outOfSceneProcessor;
     procActCheck activityCheckProcessor;
 
@@ -412,133 +1301,418 @@ namespace SimFire
                         // is in the same half-plane as the shooter if the value of the half-plane equation
                         // at the bullet position has the same sign as this reference value.
 
-    //------ Main simulation loop --------------------------------------------------------------------
-
-    while( !( noActiveObjects || collisionDetected ) )
-    {
-      uniformRectilinearMotionProcessor.reset();
-      uniformRectilinearMotionProcessor.update( mEnTTRegistry );
-
-			deltaVelocityDragProcessor.reset();
-      deltaVelocityDragProcessor.update(mEnTTRegistry);
-
-      deltaVelocityAccelerationProcessor.reset();
-      deltaVelocityAccelerationProcessor.update( mEnTTRegistry );
+    procCAT approachTracker( runParams, targetPos, nVectNear, dConstNear, referenceValueNearNegative,
+      mSettings.GetSubTickApproach() && IntegratorType_t::kDormandPrince != mIntegrator );
+    approachTracker.start( viewPos.get<cpPosition>( bullet ), viewV.get<cpVelocity>( bullet ), actSimTime );
+                        // Adaptive integrator locates the closest approach in its dense output, the
+                        // sub-tick search along the chord of a long step would be less accurate.
+
+    std::optional<procDOPRI> adaptiveProcessor;
+    if( IntegratorType_t::kDormandPrince == mIntegrator )
+      adaptiveProcessor.emplace( mEnTTRegistry, dt, mSettings.GetG(),
+        mSettings.GetDensity(), mSettings.GetAbsTolerance(), mSettings.GetRelTolerance(),
+        bullet, approachTracker, std::move( mBuffers->staticColliders ), std::move( mBuffers->bodies ) );
+                        // Adaptive integrator replaces all the processors below, time step dt is used
+                        // only as the length of the first trial step.
+
+    std::optional<procFSI> fixedStepProcessor;
+    if( IntegratorType_t::kEuler != mIntegrator && IntegratorType_t::kAnalytic != mIntegrator && ! adaptiveProcessor )
+      fixedStepProcessor.emplace( mIntegrator, dt, mSettings.GetG(),
+        mSettings.GetDensity() );
+                        // Higher-order fixed-step scheme replaces motion, drag and gravity processors
+
+    std::optional<procFused> fusedProcessor;
+    if( IntegratorType_t::kEuler == mIntegrator && mSettings.GetFusedKernel() && ! sweptSpheres )
+      fusedProcessor.emplace( mEnTTRegistry, dt, mSettings.GetG(),
+        mSettings.GetDensity(), bullet, approachTracker, std::move( mBuffers->staticColliders ) );
+                        // Fused kernel replaces all the processors above (and the closest approach
+                        // bookkeeping) by a single pass over packed components of moving bodies.
 
-      outOfSceneProcessor.reset();
-      outOfSceneProcessor.update( mEnTTRegistry );
-
-      activityCheckProcessor.reset();
-      activityCheckProcessor.update( mEnTTRegistry );
-
-      noActiveObjects = !activityCheckProcessor.mAnythingActive;
-
-      objectCollisionCheckProcessor.reset();
-      objectCollisionCheckProcessor.update( mEnTTRegistry );
-
-      collisionDetected = !objectCollisionCheckProcessor.mCollidedPairs.empty();
-
-      //------ Time increment ------------------------------------------------------------------------
-
-      actSimTime += dt;
-
-      //------ Specific calculation for the bullet and target ----------------------------------------
-
-      auto bulletPos = viewPos.get<cpPosition>( bullet );
-      auto bulletV = viewV.get<cpVelocity>( bullet );
-
-      double_t distX = bulletPos.X - targetPos.X;
-      double_t distY = bulletPos.Y - targetPos.Y;
-      double_t distZ = bulletPos.Z - targetPos.Z;
-      double tgtToBulletDistSq = distX * distX + distY * distY + distZ * distZ;
+    //------ Main simulation loop --------------------------------------------------------------------
 
-      if( tgtToBulletDistSq < runParams.mMinDTgtSq )
-      {                 // New minimal distance of the bullet to the target found. It must
-                        // be stored and short/overshot status of the bullet must be determined.
+    double_t impactTime = 0.0;
+    cpPosition contactPoint{ 0.0, 0.0, 0.0 };
+                        // Time and place of the collision, if any
+
+    double_t nextLogTime = 0.0;
+                        // Adaptive steps are not aligned to log interval, log entry is written in the
+                        // first step ending after this time.
+
+    bool recedingCheck = mSettings.GetRecedingTermination();
+    bool receding = false;
+    double_t radiusSum = mEnTTRegistry.get<cpGeometry>( bullet ).radius + mEnTTRegistry.get<cpGeometry>( target ).radius;
+                        // Run may end as soon as the bullet cannot get closer to the target than the
+                        // minimal distance recorded so far nor collide with it.
+
+    if( IntegratorType_t::kAnalytic == mIntegrator )
+    {                   // Closed-form solution of the flight in vacuum replaces the main loop. The bullet
+                        // flies until it falls to the ground or touches the target, the closest approach
+                        // is searched on the whole trajectory. Only the bullet and the target are taken
+                        // into account.
+      const auto & bulletPos = viewPos.get<cpPosition>( bullet );
+      const auto & bulletV = viewV.get<cpVelocity>( bullet );
+      const OdeState_t y0{ bulletPos.X, bulletPos.Y, bulletPos.Z, bulletV.vX, bulletV.vY, bulletV.vZ };
+      double_t bulletRadius = mEnTTRegistry.get<cpGeometry>( bullet ).radius;
+      double_t targetRadius = mEnTTRegistry.get<cpGeometry>( target ).radius;
+
+      double_t groundTime = VacuumGroundTime( y0, mSettings.GetG() );
+      auto encounter = VacuumEncounter( y0, mSettings.GetG(), Point_t{ targetPos.X, targetPos.Y, targetPos.Z },
+        bulletRadius + targetRadius, groundTime );
+
+      OdeState_t y;
+      VacuumState( y0, mSettings.GetG(), encounter.minTime, y );
+      if( encounter.minDistSq < runParams.mMinDTgtSq )
+        approachTracker.store( cpPosition{ y[0], y[1], y[2] }, cpVelocity{ y[3], y[4], y[5] },
+          encounter.minTime, encounter.minDistSq );
+
+      if( encounter.contact )
+      {                 // Closest approach is the place of the first contact in this case
+        collisionDetected = true;
+        actSimTime = impactTime = encounter.contactTime;
+        contactPoint = ContactPoint( cpPosition{ y[0], y[1], y[2] }, bulletRadius, targetPos, targetRadius );
+      } // if
+      else
+      {
+        noActiveObjects = true;
+        actSimTime = groundTime;
+      } // else
+
+      for( uint64_t tick = 1; nullptr != mExportCallback; ++tick )
+      {                 // Trajectory is exported in the same time steps as the main loop would do
+        double_t t = std::min( tick * dt, actSimTime );
+        VacuumState( y0, mSettings.GetG(), t, y );
+        double_t distX = y[0] - targetPos.X;
+        double_t distY = y[1] - targetPos.Y;
+        double_t distZ = y[2] - targetPos.Z;
+        cpPosition pos{ y[0], y[1], y[2] };
+
+        mExportCallback(
+          y[0], y[1], y[2],
+          y[3], y[4], y[5],
+          std::sqrt( distX * distX + distY * distY + distZ * distZ ),
+          t,
+          ( y[5] >= 0.0 ),
+          ( y[2] < targetPos.Z ),
+          approachTracker.IsNearHalfPlane( pos ) );
+
+        if( actSimTime <= t )
+          break;
+      } // for
+    } // if
 
-        runParams.mMinDTgtSq = tgtToBulletDistSq;
-        runParams.mMinTime = actSimTime;
-                        // New minimal distance of the bullet and the time of the event is stored.
+    auto tickLoop = [&]( auto && engine, auto atmosphere, auto exportOn, auto logOn )
+    {                   // Engine (and the pipeline of processors) and observers are known at compile time,
+                        // each combination is a separate instantiation of the loop (see dispatch below).
+      using Engine_t = std::decay_t<decltype( engine )>;
 
-        runParams.mRaising = ( bulletV.vZ >= 0.0 );
-                        // Bullet is rising if its vertical velocity component is positive.
+      while( !( noActiveObjects || collisionDetected || receding ) )
+      {
+        if( nullptr != mCancelToken && 0 == actualTick % gCancelCheckTicks &&
+            mCancelToken->load( std::memory_order_relaxed ) )
+        {               // Solution was found by another run, this one is not needed any more
+          cancelled = true;
+          break;
+        } // if
+
+        uint64_t tickAllocations = 0;
+        if constexpr( gAllocationCounting )
+          tickAllocations = GetAllocationCount();
+
+        if constexpr( std::is_same_v<Engine_t, procDOPRI> )
+        {
+          engine.reset();
+          {
+            [[maybe_unused]] auto timer = StartProcTimer( ProfiledProc_t::kDOPRI );
+            engine.update( actSimTime );
+          }
+
+          if( engine.mStepFailed )
+            break;
+
+          noActiveObjects = !engine.mAnythingActive;
+          collisionDetected = engine.mCollisionDetected;
+          impactTime = engine.mImpactTime;
+          contactPoint = engine.mContactPoint;
+        } // if
+        else if constexpr( std::is_same_v<Engine_t, procFused> )
+        {
+          actSimTime += dt;
+
+          engine.reset();
+          {
+            [[maybe_unused]] auto timer = StartProcTimer( ProfiledProc_t::kFused );
+            engine.template update<decltype( atmosphere )::value>( actSimTime );
+          }
+
+          noActiveObjects = !engine.mAnythingActive;
+          collisionDetected = engine.mCollisionDetected;
+          impactTime = actSimTime;
+          contactPoint = engine.mContactPoint;
+        } // if
+        else
+        {
+          engine.reset();
+          engine.update( mEnTTRegistry );
+                        // Motion (procPPS, procFSI or procURM, procADRG, procDVA), out of scene,
+                        // activity and collision checks
 
-        runParams.mBelow = ( bulletPos.Z < targetPos.Z );
-                        // Bullet is below the target if its Z coordinate is lower than the target Z coordinate.
+          noActiveObjects = !activityCheckProcessor.mAnythingActive;
+          collisionDetected = !objectCollisionCheckProcessor.mCollidedPairs.empty();
 
-        double bRefVal = nVectNear.X * bulletPos.X + nVectNear.Y * bulletPos.Y + nVectNear.Z * bulletPos.Z + dConstNear;
-        runParams.mNearHalfPlane = ( referenceValueNearNegative ? ( bRefVal < 0.0 ) : ( bRefVal > 0.0 ) );
-                        // Bullet is in the same half-plane as the shooter if the value of the half-space 
-                        // plane equation at the bullet position has the same sign as the reference value.
+          //------ Time increment --------------------------------------------------------------------
 
-      } // if
+          actSimTime += dt;
 
-      //------ Tick increment and logging ------------------------------------------------------------
+          //------ Specific calculation for the bullet and target ------------------------------------
 
-			bool logNow = (nullptr != mLogCallback && 0 < logTicks && 0 == (actualTick % logTicks));
+          cpPosition approachPos = viewPos.get<cpPosition>( bullet );
+          double_t approachTime = actSimTime;
 
-      if( nullptr != mExportCallback || logNow )
-      {
+          if( collisionDetected )
+          {
+            const auto & collision = objectCollisionCheckProcessor.mCollidedPairs.front();
+            impactTime = actSimTime - ( 1.0 - collision.fraction ) * dt;
+            contactPoint = collision.contact;
 
-        auto view = mEnTTRegistry.view<const cpId, const cpPosition, const cpVelocity>();
-        auto [id, pos, vel] = view.get<const cpId, const cpPosition, const cpVelocity>( bullet );
+            if( sweptSpheres && ( bullet == collision.first || bullet == collision.second ) )
+            {           // Bullet does not continue through the target, its position at the moment of impact
+                        // is the last one that counts. If it crossed the ground in the same tick, but later
+                        // than it touched the target, it is a hit.
+              const auto & prev = mEnTTRegistry.get<cpPrevPosition>( bullet );
+              if( noActiveObjects && approachPos.Z <= 0.0 && collision.fraction * ( prev.Z - approachPos.Z ) <= prev.Z )
+                noActiveObjects = false;
 
-        double bRefVal = nVectNear.X * pos.X + nVectNear.Y * pos.Y + nVectNear.Z * pos.Z + dConstNear;
-        bool nearHalfPlane = ( referenceValueNearNegative ? ( bRefVal < 0.0 ) : ( bRefVal > 0.0 ) );
+              approachPos = cpPosition{ prev.X + collision.fraction * ( approachPos.X - prev.X ),
+                prev.Y + collision.fraction * ( approachPos.Y - prev.Y ), prev.Z + collision.fraction * ( approachPos.Z - prev.Z ) };
+              approachTime = impactTime;
+            } // if
+          } // if
 
-        if( nullptr != mExportCallback )
+          approachTracker.reset();
+          {
+            [[maybe_unused]] auto timer = StartProcTimer( ProfiledProc_t::kCAT );
+            approachTracker.update( approachPos, viewV.get<cpVelocity>( bullet ), approachTime );
+          }
+                        // New minimal distance of the bullet to the target and short/overshot status
+                        // of the bullet are stored into run parameters.
+        } // else
+
+        double_t tgtToBulletDistSq = approachTracker.mDistSq;
+
+        if( recedingCheck && !( noActiveObjects || collisionDetected ) )
+        {               // Cheap half-plane test first, the kinematic bound is evaluated only behind
+                        // the target.
+          const auto & pos = viewPos.get<cpPosition>( bullet );
+          const auto & vel = viewV.get<cpVelocity>( bullet );
+          receding = ! approachTracker.IsNearHalfPlane( pos ) &&
+            ProvablyReceding( pos.X - targetPos.X, pos.Y - targetPos.Y, vel.vX, vel.vY,
+              std::max( runParams.mMinDTgtSq, radiusSum * radiusSum ) );
+        } // if
+
+        if constexpr( gAllocationCounting )
+          mTickAllocations = std::max( mTickAllocations, GetAllocationCount() - tickAllocations );
+
+        //------ Tick increment and logging ----------------------------------------------------------
+
+        bool logNow = false;
+        if constexpr( decltype( logOn )::value )
         {
-          mExportCallback(
-            pos.X, pos.Y, pos.Z,
-            vel.vX, vel.vY, vel.vZ,
-            std::sqrt( tgtToBulletDistSq ),
-            actSimTime,
-            ( vel.vZ >= 0.0 ),
-            ( pos.Z < targetPos.Z ),
-						nearHalfPlane);
-        }
-
-        if (logNow)
-        {
-          std::string mssg = FormatStr("In t = %.4f: Bullet pos = [%.3f, %.3f, %.3f], v = [%.3f, %.3f, %.3f], %s, %s, %s",
-            actSimTime,
-            pos.X, pos.Y, pos.Z,
-            vel.vX, vel.vY, vel.vZ,
-            (nearHalfPlane ? "near" : "far"),
-            (pos.Z < targetPos.Z ? "under" : "above"),
-            (vel.vZ < 0.0 ? "falling" : "raising"));
-
-          mLogCallback(runParams.mThreadIdentifier + ":" + mRunId, mssg);
-        }
-      } // if
-
-      ++actualTick;
-      if( actualTick >= maxTicks )
-        break;
+          if constexpr( std::is_same_v<Engine_t, procDOPRI> )
+          {
+            logNow = ( nextLogTime <= actSimTime );
+            if( logNow )
+              nextLogTime = ( std::floor( actSimTime / mSettings.GetLogInterval() ) + 1.0 ) * mSettings.GetLogInterval();
+          } // if
+          else
+            logNow = ( 0 == ( actualTick % logTicks ) );
+        } // if
 
-    } // while
+        if constexpr( decltype( exportOn )::value || decltype( logOn )::value )
+        {
+          if( decltype( exportOn )::value || logNow )
+          {
+            auto view = mEnTTRegistry.view<const cpId, const cpPosition, const cpVelocity>();
+            auto [id, pos, vel] = view.get<const cpId, const cpPosition, const cpVelocity>( bullet );
+
+            bool nearHalfPlane = approachTracker.IsNearHalfPlane( pos );
+
+            if constexpr( decltype( exportOn )::value )
+            {
+              mExportCallback(
+                pos.X, pos.Y, pos.Z,
+                vel.vX, vel.vY, vel.vZ,
+                std::sqrt( tgtToBulletDistSq ),
+                actSimTime,
+                ( vel.vZ >= 0.0 ),
+                ( pos.Z < targetPos.Z ),
+                nearHalfPlane );
+            } // if
+
+            if( logNow )
+            {
+              std::string mssg = FormatStr("In t = %.4f: Bullet pos = [%.3f, %.3f, %.3f], v = [%.3f, %.3f, %.3f], %s, %s, %s",
+                actSimTime,
+                pos.X, pos.Y, pos.Z,
+                vel.vX, vel.vY, vel.vZ,
+                (nearHalfPlane ? "near" : "far"),
+                (pos.Z < targetPos.Z ? "under" : "above"),
+                (vel.vZ < 0.0 ? "falling" : "raising"));
+
+              WriteLogMessage( LogLevel_t::kTrace,
+                runParams.GetThreadIdentifier() + ":" + runParams.GetRunIdentifier(), mssg );
+            } // if
+          } // if
+        } // if
+
+        ++actualTick;
+        if( actualTick >= maxTicks )
+          break;
+
+      } // while
+    }; // tickLoop
+
+    //------ Dispatch to the instantiation of the loop ---------------------------------------------
+
+    bool exportOn = ( nullptr != mExportCallback );
+    bool logOn = ( IsLogEnabled( LogLevel_t::kTrace ) &&
+      ( adaptiveProcessor ? IsPositive( mSettings.GetLogInterval() ) : 0 < logTicks ) );
+
+    auto observedLoop = [&]( auto && engine, auto atmosphere )
+    {                   // Observers do not change during the run, they are resolved only once
+      if( exportOn && logOn )
+        tickLoop( engine, atmosphere, std::true_type{}, std::true_type{} );
+      else if( exportOn )
+        tickLoop( engine, atmosphere, std::true_type{}, std::false_type{} );
+      else if( logOn )
+        tickLoop( engine, atmosphere, std::false_type{}, std::true_type{} );
+      else
+        tickLoop( engine, atmosphere, std::false_type{}, std::false_type{} );
+    }; // observedLoop
+
+    bool atmosphere = ! mSettings.InVacuum();
+                        // Closed-form solution (see above) ends before the first tick, so it may go
+                        // through any instantiation.
+
+    if( adaptiveProcessor )
+      observedLoop( *adaptiveProcessor, std::true_type{} );
+    else if( fusedProcessor )
+    {
+      if( atmosphere )
+        observedLoop( *fusedProcessor, std::true_type{} );
+      else
+        observedLoop( *fusedProcessor, std::false_type{} );
+    } // else if
+    else if( fixedStepProcessor )
+    {                   // Higher-order schemes include drag themselves
+      if( sweptSpheres )
+        observedLoop( procPipeline( prevPositionProcessor, *fixedStepProcessor, outOfSceneProcessor,
+          activityCheckProcessor, objectCollisionCheckProcessor ), std::true_type{} );
+      else
+        observedLoop( procPipeline( *fixedStepProcessor, outOfSceneProcessor,
+          activityCheckProcessor, objectCollisionCheckProcessor ), std::true_type{} );
+    } // else if
+    else if( sweptSpheres && atmosphere )
+      observedLoop( procPipeline( prevPositionProcessor, uniformRectilinearMotionProcessor,
+        deltaVelocityDragProcessor, deltaVelocityAccelerationProcessor, outOfSceneProcessor,
+        activityCheckProcessor, objectCollisionCheckProcessor ), std::true_type{} );
+    else if( sweptSpheres )
+      observedLoop( procPipeline( prevPositionProcessor, uniformRectilinearMotionProcessor,
+        deltaVelocityAccelerationProcessor, outOfSceneProcessor,
+        activityCheckProcessor, objectCollisionCheckProcessor ), std::false_type{} );
+    else if( atmosphere )
+      observedLoop( procPipeline( uniformRectilinearMotionProcessor,
+        deltaVelocityDragProcessor, deltaVelocityAccelerationProcessor, outOfSceneProcessor,
+        activityCheckProcessor, objectCollisionCheckProcessor ), std::true_type{} );
+    else
+      observedLoop( procPipeline( uniformRectilinearMotionProcessor,
+        deltaVelocityAccelerationProcessor, outOfSceneProcessor,
+        activityCheckProcessor, objectCollisionCheckProcessor ), std::false_type{} );
 
     runParams.mSimTime = actSimTime;
+    runParams.mSteps = actualTick;
+    if( adaptiveProcessor )
+    {
+      runParams.mRejectedSteps = adaptiveProcessor->mRejectedSteps;
+      runParams.mMinStep = adaptiveProcessor->mMinStep;
+      runParams.mMaxStep = adaptiveProcessor->mMaxStep;
+    } // if
+    else if( IntegratorType_t::kAnalytic == mIntegrator )
+    {                   // No time stepping at all
+      runParams.mRejectedSteps = 0;
+      runParams.mMinStep = runParams.mMaxStep = 0.0;
+    } // else if
+    else
+    {
+      runParams.mRejectedSteps = 0;
+      runParams.mMinStep = runParams.mMaxStep = dt;
+    } // else
+
+    if( persistent )
+    {                   // Buffers are handed over to the following run
+      mBuffers->entities = std::move( objectCollisionCheckProcessor.mEntities );
+      mBuffers->collisions = std::move( objectCollisionCheckProcessor.mCollidedPairs );
+      if( fusedProcessor )
+        mBuffers->staticColliders = std::move( fusedProcessor->mStaticColliders );
+      if( adaptiveProcessor )
+      {
+        mBuffers->staticColliders = std::move( adaptiveProcessor->mStaticColliders );
+        mBuffers->bodies = std::move( adaptiveProcessor->mBodies );
+      } // if
+    } // if
 
-    if( noActiveObjects )
+    if( adaptiveProcessor && adaptiveProcessor->mStepFailed )
+    {
+      runParams.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kError;
+      SIMFIRE_LOG( *this, LogLevel_t::kWarning, runParams.GetRunIdentifier(),
+        "Simulation ended: integration step too short, tolerances cannot be met." );
+      return -1;
+    }
+    else if( noActiveObjects )
     {
       runParams.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kEndedNoActive;
-      if( nullptr != mLogCallback )
-        mLogCallback( mRunId, "Simulation ended: no active objects left in the scene." );
+      SIMFIRE_LOG( *this, LogLevel_t::kTrace, runParams.GetRunIdentifier(),
+        "Simulation ended: no active objects left in the scene." );
     }
     else if( collisionDetected )
     {
       runParams.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kEndedCollision;
-      if( nullptr != mLogCallback )
-        mLogCallback( mRunId, "Simulation ended: collision detected." );
+      runParams.mImpactTime = impactTime;
+      runParams.mContactX = contactPoint.X;
+      runParams.mContactY = contactPoint.Y;
+      runParams.mContactZ = contactPoint.Z;
+      if( nullptr != mCancelToken && mSettings.GetStopOnFirstHit() )
+        mCancelToken->store( true, std::memory_order_relaxed );
+                        // Sibling runs are cancelled, the first solution is enough
+      SIMFIRE_LOG( *this, LogLevel_t::kTrace, runParams.GetRunIdentifier(), "Simulation ended: collision detected." );
+    }
+    else if( receding )
+    {
+      runParams.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kEndedReceding;
+      SIMFIRE_LOG( *this, LogLevel_t::kTrace, runParams.GetRunIdentifier(),
+        "Simulation ended: bullet is receding from the target." );
+    }
+    else if( cancelled )
+    {
+      runParams.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kCancelled;
+      SIMFIRE_LOG( *this, LogLevel_t::kTrace, runParams.GetRunIdentifier(),
+        "Simulation cancelled: solution was already found." );
     }
     else
     {
       runParams.mReturnCode = CSimFireSingleRunParams::SimResCode_t::kEndedMaxTicks;
-      if( nullptr != mLogCallback )
-        mLogCallback( mRunId, "Simulation ended: maximum number of ticks reached." );
+      SIMFIRE_LOG( *this, LogLevel_t::kTrace, runParams.GetRunIdentifier(),
+        "Simulation ended: maximum number of ticks reached." );
     }
 
+    if constexpr( gAllocationCounting )
+    {
+      mRunAllocations = GetAllocationCount() - runAllocations;
+      assert( ! persistent || ! mWarmedUp || 0 == mTickAllocations );
+      assert( ! persistent || ! mWarmedUp || nullptr != mExportCallback ||
+        IsLogEnabled( LogLevel_t::kTrace ) ||
+        0 == mRunAllocations );
+    } // if
+    mWarmedUp = persistent;
 
     return 0;
 
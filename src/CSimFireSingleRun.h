@@ -10,9 +10,13 @@
 #ifndef H_CSimFireSingleRun
 #define H_CSimFireSingleRun
 
+#include <atomic>
+#include <memory>
+
 #include <entity/registry.hpp>
 
 #include <SimFireGlobals.h>
+#include <CSimFireLogger.h>
 #include <CSimFireSettings.h>
 #include <CSimFireSingleRunParams.h>
 
@@ -27,11 +31,12 @@ namespace SimFire
 
   public:
 
-    using LogCallback_t = std::function <void( const std::string &, const std::string & )>;
+    using LogCallback_t = std::function <void( LogLevel_t, const std::string &, const std::string & )>;
     //!< This is a type of a method that responds to a journal message request.
 
 #define BIND_SINGLE_RUN_LOG_CALLBACK( classPtr, fnName )                          \
-         std::bind( &fnName, (classPtr), std::placeholders::_1, std::placeholders::_2 )
+         std::bind( &fnName, (classPtr),                                          \
+         std::placeholders::_1, std::placeholders::_2, std::placeholders::_3 )
     //!< This macro allows one to specify a member function of other class as a logging callback.
 
 		using ExportCallback_t = std::function <void(
@@ -74,12 +79,51 @@ namespace SimFire
      
 				\param[in] fnCall Callback method */
 
+    void SetCancelToken( std::atomic<bool> * cancelToken ) { mCancelToken = cancelToken; }
+    /*! \brief Sets token shared by runs which may be cancelled together. Running simulation checks it
+        every gCancelCheckTicks ticks and ends with kCancelled code once it is set. If the user needs
+        only the first solution (see CSimFireSettings::GetStopOnFirstHit), a run which hits the target
+        sets the token itself.
+
+        \param[in] cancelToken Cancellation token, nullptr if the run cannot be cancelled */
+
+    void SetIntegrator( IntegratorType_t integrator ) { mIntegrator = integrator; }
+    /*! \brief Overrides integration method given by settings (used to verify analytic solutions)
+
+        \param[in] integrator Integration method */
+
+    static double_t EstimateFlightTime( const CSimFireSettings & settings, const CSimFireSingleRunParams & runParams );
+    /*! \brief Estimates duration of the run from its aim vector without simulating it: flight time
+        of the bullet to the ground in vacuum. Drag and termination on hit make actual runs shorter,
+        but the estimate keeps their order (higher elevation flies longer), which is what scheduling
+        of runs needs.
+
+        \param[in] settings  Settings of the simulation
+        \param[in] runParams Parameters of the run (aim vector)
+        \return Estimated simulated time of the run [s] */
+
+    uint64_t GetRunAllocations() const { return mRunAllocations; }
+    /*! \brief Returns number of heap allocations made by the last run (counted only if compiled with
+        SIMFIRE_COUNT_ALLOCATIONS, see SimFireAllocCounter.h) */
+
+    uint64_t GetTickAllocations() const { return mTickAllocations; }
+    /*! \brief Returns the highest number of heap allocations made by a single tick of the last run
+        (counted only if compiled with SIMFIRE_COUNT_ALLOCATIONS) */
+
     //@}---------------------------------------------------------------------------------------------
     //! @name Protected data                                                                            
     //@{----------------------------------------------------------------------------------------------
 
   protected:
 
+    bool IsLogEnabled( LogLevel_t level ) const
+      { return gLogFloor <= level && nullptr != mLogCallback && mSettings.GetLogLevel() <= level; }
+    //!< \brief Returns true if messages of given level are logged (see SIMFIRE_LOG)
+
+    void WriteLogMessage( LogLevel_t level, const std::string & id, const std::string & mssg )
+      { mLogCallback( level, id, mssg ); }
+    //!< \brief Passes the message to the logging callback (see SIMFIRE_LOG)
+
     const CSimFireSettings & mSettings;
 		//<! Reference to settings object, which contains all parameters entered by user on startup
 
@@ -89,15 +133,34 @@ namespace SimFire
 		ExportCallback_t mExportCallback;
 		//!< Callback method for exporting state of the simulation at given time step
 
-    std::string mRunId;
-		//!< Identifier of the current run, taken from run parameters
+    std::atomic<bool> * mCancelToken;
+		//!< Token cancelling the run when set (see SetCancelToken), nullptr if not cancellable
 
-    std::string mThreadId;
-		//!< Identifier of the thread that is processing the current run
+    IntegratorType_t mIntegrator;
+		//!< Integration method, taken from settings unless overridden
 
     entt::registry mEnTTRegistry;
 		//!< EnTT registry containing all entities and components of the current simulation
 
+    struct RunBuffers_t;
+    std::unique_ptr<RunBuffers_t> mBuffers;
+		//!< Buffers of processors kept between runs in persistent mode (see CSimFireSingleRun.cpp)
+
+    entt::entity mBullet;
+		//!< Bullet entity, reused by the following run in persistent mode
+
+    entt::entity mTarget;
+		//!< Target entity, reused by the following run in persistent mode
+
+    bool mWarmedUp;
+		//!< True after the first run in persistent mode, buffers have their final capacity then
+
+    uint64_t mRunAllocations;
+		//!< Heap allocations made by the last run (see GetRunAllocations)
+
+    uint64_t mTickAllocations;
+		//!< Highest number of heap allocations made by a single tick of the last run
+
     static const char * mBulletIdString;
 		//<! String identifier of the bullet entity
 
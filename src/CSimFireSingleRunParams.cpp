@@ -19,26 +19,32 @@ namespace SimFire
    //****** CCSimFireSingleRunParams *****************************************************************
 
    CSimFireSingleRunParams::CSimFireSingleRunParams():
-     mRunIdentifier(),
      mVelocityXCoef( 1.0 ),
      mVelocityYCoef( 0.0 ),
      mVelocityZCoef( 1.0 ),
-     mReturnCode( SimResCode_t::kUnknown ),
      mMinDTgtSq( 1e99 ),
      mMinTime( 0.0 ),
      mSimTime( 0.0 ),
+     mReturnCode( SimResCode_t::kUnknown ),
      mNearHalfPlane( false ),
      mRaising( false ),
-     mBelow( false )
+     mBelow( false ),
+     mRunLabel( RunLabel_t::kRun ),
+     mThreadLabel( ThreadLabel_t::kNone ),
+     mThreadNr( 0 ),
+     mRunNr( 0 ),
+     mImpactTime( 0.0 ),
+     mContactX( 0.0 ),
+     mContactY( 0.0 ),
+     mContactZ( 0.0 ),
+     mSteps( 0 ),
+     mRejectedSteps( 0 ),
+     mMinStep( 0.0 ),
+     mMaxStep( 0.0 )
    {
 
    } /* CSimFireSingleRunParams::CSimFireSingleRunParams */
 
-
-   //-------------------------------------------------------------------------------------------------
-
-   CSimFireSingleRunParams::~CSimFireSingleRunParams() = default;
-
    //-------------------------------------------------------------------------------------------------
 
    std::ostream & CSimFireSingleRunParams::PrpLine( std::ostream & out )
@@ -50,7 +56,7 @@ namespace SimFire
 
    std::ostream& CSimFireSingleRunParams::Preprint( std::ostream & out  )
    { 
-     PrpLine( out ) << "RunIdentifier" << mRunIdentifier << std::endl << std::endl;
+     PrpLine( out ) << "RunIdentifier" << GetRunIdentifier() << std::endl << std::endl;
 
      PrpLine( out ) << "VelocityXCoef" << mVelocityXCoef << std::endl;
      PrpLine( out ) << "VelocityYCoef" << mVelocityYCoef << std::endl;
@@ -73,10 +79,16 @@ namespace SimFire
      mMinDTgtSq = 1e99;
      mMinTime = 0.0;
      mSimTime = 0.0;
+     mImpactTime = 0.0;
+     mContactX = mContactY = mContactZ = 0.0;
      mNearHalfPlane = false;
      mRaising = false;
      mBelow = false;
      mReturnCode = SimResCode_t::kNotStarted;
+     mSteps = 0;
+     mRejectedSteps = 0;
+     mMinStep = 0.0;
+     mMaxStep = 0.0;
    } // Reset
 
    //-------------------------------------------------------------------------------------------------
@@ -90,6 +102,8 @@ namespace SimFire
      static const std::string lEndedNoActive( "EndedNoActive" );
      static const std::string lEndedCollision( "EndedCollision" );
      static const std::string lEndedMaxTicks( "EndedMaxTicks" );
+     static const std::string lEndedReceding( "EndedReceding" );
+     static const std::string lCancelled( "Cancelled" );
      static const std::string lError( "Error" );
      static const std::string lInvalidCode( "InvalidCode" );
 
@@ -101,6 +115,8 @@ namespace SimFire
        case SimResCode_t::kEndedNoActive:    return lEndedNoActive;
        case SimResCode_t::kEndedCollision:   return lEndedCollision;
        case SimResCode_t::kEndedMaxTicks:    return lEndedMaxTicks;
+       case SimResCode_t::kEndedReceding:    return lEndedReceding;
+       case SimResCode_t::kCancelled:        return lCancelled;
        case SimResCode_t::kError:            return lError;
        default:                              return lInvalidCode;
      } // switch
@@ -108,8 +124,71 @@ namespace SimFire
 
    //-------------------------------------------------------------------------------------------------
 
+   const std::string & CSimFireSingleRunParams::GetStrValue( RunLabel_t label )
+   {
+
+     static const std::string lRun( "RUN" );
+     static const std::string lTestRun( "TRUN" );
+     static const std::string lBench( "BENCH" );
+     static const std::string lLowArc( "LOW_ARC" );
+     static const std::string lHighArc( "HIGH_ARC" );
+     static const std::string lInvalidCode( "InvalidCode" );
+
+     switch( label )
+     {
+       case RunLabel_t::kRun:                return lRun;
+       case RunLabel_t::kTestRun:            return lTestRun;
+       case RunLabel_t::kBench:              return lBench;
+       case RunLabel_t::kLowArc:             return lLowArc;
+       case RunLabel_t::kHighArc:            return lHighArc;
+       default:                              return lInvalidCode;
+     } // switch
+   } // GetStrValue
+
+   //-------------------------------------------------------------------------------------------------
 
-   std::string CSimFireSingleRunParams::GetRunDesc()
+   const std::string & CSimFireSingleRunParams::GetStrValue( ThreadLabel_t label )
+   {
+
+     static const std::string lNone( "" );
+     static const std::string lWorker( "THRD" );
+     static const std::string lCache( "CACHE" );
+     static const std::string lMain( "Main" );
+     static const std::string lCore( "CORE" );
+     static const std::string lInvalidCode( "InvalidCode" );
+
+     switch( label )
+     {
+       case ThreadLabel_t::kNone:            return lNone;
+       case ThreadLabel_t::kWorker:          return lWorker;
+       case ThreadLabel_t::kCache:           return lCache;
+       case ThreadLabel_t::kMain:            return lMain;
+       case ThreadLabel_t::kCore:            return lCore;
+       default:                              return lInvalidCode;
+     } // switch
+   } // GetStrValue
+
+   //-------------------------------------------------------------------------------------------------
+
+   std::string CSimFireSingleRunParams::GetRunIdentifier() const
+   {
+     if( RunLabel_t::kRun == mRunLabel )
+       return FormatStr( "%s_%02u", GetStrValue( mRunLabel ), mRunNr );
+     return GetStrValue( mRunLabel );
+   } // GetRunIdentifier
+
+   //-------------------------------------------------------------------------------------------------
+
+   std::string CSimFireSingleRunParams::GetThreadIdentifier() const
+   {
+     if( ThreadLabel_t::kWorker == mThreadLabel )
+       return FormatStr( "%s_%02u", GetStrValue( mThreadLabel ), (uint32_t)mThreadNr );
+     return GetStrValue( mThreadLabel );
+   } // GetThreadIdentifier
+
+   //-------------------------------------------------------------------------------------------------
+
+   std::string CSimFireSingleRunParams::GetRunDesc() const
    {
        return FormatStr( "run [%f, %f, %f], dist = %f m, dt = %.2f s, %s, %s, %s ",
          mVelocityXCoef, mVelocityYCoef, mVelocityZCoef,
@@ -119,5 +198,14 @@ namespace SimFire
 				 mBelow ? "under" : "above" );
 	 } // GetRunDesc
 
+   //-------------------------------------------------------------------------------------------------
+
+   std::string CSimFireSingleRunParams::GetStepsDesc() const
+   {
+       return FormatStr( "%llu steps (%llu rejected), step <%g, %g> s",
+         mSteps, mRejectedSteps,
+         mMinStep, mMaxStep );
+   } // GetStepsDesc
+
 
 } // namespace PEGLDPCgenerator
@@ -11,7 +11,9 @@
 #ifndef H_CSimFireSingleRunParams
 #define H_CSimFireSingleRunParams
 
+#include <cstddef>
 #include <iostream>
+#include <type_traits>
 
 #include <SimFireGlobals.h>
 #include <CSimFireConfig.h>
@@ -21,8 +23,13 @@ namespace SimFire
 
   //***** CSimFireSingleRunParams *****************************************************************************
 
-  /*!  \brief Class describes parameters and results of a single simulation run. */
-  class CSimFireSingleRunParams
+  /*!  \brief Class describes parameters and results of a single simulation run. It is a trivially
+       copyable record aligned to cache lines, so that whole populations are stored in compact arrays
+       and workers writing results of neighbouring runs never share a cache line. The first cache line
+       holds everything the genetic algorithm works with, statistics of the run are in the second one.
+       Identifiers of the run and of the thread are kept as labels and numbers, their strings are
+       built only when a message is logged (see GetRunIdentifier, GetThreadIdentifier). */
+  class alignas( gCacheLineSize ) CSimFireSingleRunParams
   {
 
   public:
@@ -35,17 +42,35 @@ namespace SimFire
       kEndedNoActive    = 3,    //!< Simulation ended: no active objects left in the scene
       kEndedCollision   = 4,    //!< Simulation ended: collision detected
       kEndedMaxTicks    = 5,    //!< Simulation ended: maximum number of ticks reached
+      kEndedReceding    = 6,    //!< Simulation ended: bullet is provably receding from the target
+      kCancelled        = 7,    //!< Simulation cancelled: solution was already found by another run
       kError            = 100   //!< Simulation ended with error
     };
 
+    enum class RunLabel_t: uint8_t
+    {
+      kRun              = 0,    //!< Run of the genetic algorithm, identifier RUN_<run number>
+      kTestRun          = 1,    //!< Shot of the test sweep, identifier TRUN
+      kBench            = 2,    //!< Shot of the benchmark, identifier BENCH
+      kLowArc           = 3,    //!< Analytic solution with low arc, identifier LOW_ARC
+      kHighArc          = 4     //!< Analytic solution with high arc, identifier HIGH_ARC
+    };
+
+    enum class ThreadLabel_t: uint8_t
+    {
+      kNone             = 0,    //!< Run was not processed yet
+      kWorker           = 1,    //!< Pool worker, identifier THRD_<thread number>
+      kCache            = 2,    //!< Result was taken from the evaluation cache, identifier CACHE
+      kMain             = 3,    //!< Main thread, identifier Main
+      kCore             = 4     //!< Core of the simulation (analytic solution), identifier CORE
+    };
+
     //------------------------------------------------------------------------------------------------
     //! @name Constructors, destructor, clonning, assign operators                                   
     //@{----------------------------------------------------------------------------------------------
 
     CSimFireSingleRunParams();
 
-    virtual ~CSimFireSingleRunParams();
-
    //@}-----------------------------------------------------------------------------------------------
    //! @name Public methods  */
    //@{-----------------------------------------------------------------------------------------------
@@ -61,7 +86,34 @@ namespace SimFire
          \param[in] code Simulation result code
          \return String representation of the code */
 
-    std::string GetRunDesc();
+    static const std::string & GetStrValue( RunLabel_t label );
+    /*!< \brief Returns string representation of given run label.
+   
+         \param[in] label Run label
+         \return String representation of the label */
+
+    static const std::string & GetStrValue( ThreadLabel_t label );
+    /*!< \brief Returns string representation of given thread label.
+   
+         \param[in] label Thread label
+         \return String representation of the label */
+
+    std::string GetRunIdentifier() const;
+    /*!< \brief Builds identifier of the run from its label and number.
+   
+         \return Identifier of the run (e.g. RUN_05) */
+
+    std::string GetThreadIdentifier() const;
+    /*!< \brief Builds identifier of the thread that processed the run from its label and number.
+   
+         \return Identifier of the thread (e.g. THRD_02), empty if the run was not processed yet */
+
+    std::string GetStepsDesc() const;
+    /*!< \brief Returns brief description of integration steps statistics of the run.
+   
+         \return String description of steps statistics */
+
+    std::string GetRunDesc() const;
     /*!< \brief Returns brief description of the run (identifier and velocity coefficients).
    
          \return String description of the run */
@@ -73,29 +125,43 @@ namespace SimFire
          \param[in] inclVelCoefs If true, also input velocity coefficients are reset to zero. */
 
     //@{}---------------------------------------------------------------------------------------------
-    //! @name Public data                                                                            
+    //! @name Public data (the first cache line)
     //@{----------------------------------------------------------------------------------------------
 
-    std::string mRunIdentifier;   //!< Simulation run identifier
-    std::string mThreadIdentifier;//!< Identifier of the thread that processed this run
-
     double_t mVelocityXCoef;      //!< X aim of the shooter
     double_t mVelocityYCoef;      //!< Y aim of the shooter
     double_t mVelocityZCoef;      //!< Z aim of the shooter
 
-    //@}----------------------------------------------------------------------------------------------
-    //! @name Public output data                                                                            
-    //@{----------------------------------------------------------------------------------------------
-
     double_t mMinDTgtSq;//!< Minimal distance of the bullet to the target in the last completed run squared [m^2]
     double_t mMinTime;  //!< Time when the minimal distance was reached in the last completed run [s]
+    double_t mSimTime;  //!< Total simulation time [s]
+    SimResCode_t mReturnCode;
+                        //!< Result code of the simulation run
     bool mNearHalfPlane;//!< \b true if the bullet passed target in half-plane containing the shooter
     bool mRaising;      //!< \b true if the bullet was rising when it reached the minimal distance to the target
     bool mBelow;        //!< \b true if the bullet was below the target when it reached the minimal distance to the target
 
-    double_t mSimTime;  //!< Total simulation time [s]
-    SimResCode_t mReturnCode;
-                        //!< Result code of the simulation run
+    RunLabel_t mRunLabel;         //!< Kind of the run, gives its identifier together with mRunNr
+    ThreadLabel_t mThreadLabel;   //!< Kind of the thread that processed this run, gives its identifier
+                                  //!  together with mThreadNr
+    uint16_t mThreadNr; //!< Number of the thread that processed this run (pool workers only, from 1)
+    uint32_t mRunNr;    //!< Number of the run (runs of the genetic algorithm only, from 1)
+
+    //@}----------------------------------------------------------------------------------------------
+    //! @name Public output data (the second cache line, statistics of the run)
+    //@{----------------------------------------------------------------------------------------------
+
+    double_t mImpactTime;
+                        //!< Time of impact, when the bullet touched the target (hits only) [s]
+    double_t mContactX; //!< X position of the contact point of the bullet and the target (hits only) [m]
+    double_t mContactY; //!< Y position of the contact point of the bullet and the target (hits only) [m]
+    double_t mContactZ; //!< Z position of the contact point of the bullet and the target (hits only) [m]
+
+    uint64_t mSteps;    //!< Number of (accepted) integration steps, equals number of ticks for fixed step
+    uint64_t mRejectedSteps;
+                        //!< Number of steps rejected by the adaptive integrator (error too large)
+    double_t mMinStep;  //!< Shortest accepted integration step [s]
+    double_t mMaxStep;  //!< Longest accepted integration step [s]
 
   protected:
 
@@ -106,6 +172,12 @@ namespace SimFire
 
   }; // CSimFireSingleRunParams
 
+  static_assert( std::is_trivially_copyable_v<CSimFireSingleRunParams> &&
+                 std::is_standard_layout_v<CSimFireSingleRunParams> );
+  static_assert( gCacheLineSize == offsetof( CSimFireSingleRunParams, mImpactTime ) &&
+                 2 * gCacheLineSize == sizeof( CSimFireSingleRunParams ),
+                 "Data used by the genetic algorithm must fill exactly the first cache line" );
+
 } // namespace SimFire
 
 #endif
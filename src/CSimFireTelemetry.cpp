@@ -0,0 +1,127 @@
+//****************************************************************************************************
+//! \file CSimFireTelemetry.cpp
+//! Module contains definitions of CSimFireTelemetry class, declared in CSimFireTelemetry.h, which
+//! exports statistics of generations of the genetic algorithm.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <CSimFireTelemetry.h>
+#include <SimFireStringTools.h>
+
+namespace SimFire
+{
+
+  //****** CSimFireTelemetry *************************************************************************
+
+  CSimFireTelemetry::CSimFireTelemetry( const std::string & filename, TelemetryFormat_t format ):
+    mFile( filename, std::ios::out | std::ios::trunc ),
+    mFormat( format ),
+    mNWorkers( 0 ),
+    mLine()
+  {
+  } // CSimFireTelemetry::CSimFireTelemetry
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireTelemetry::~CSimFireTelemetry()
+  {
+    if( mFile.is_open() )
+      mFile.close();
+  } // CSimFireTelemetry::~CSimFireTelemetry
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireTelemetry::WriteSetup(
+    const std::string & identifier,
+    uint64_t seed,
+    uint32_t nWorkers,
+    const std::string & mode )
+  {
+    mNWorkers = nWorkers;
+
+    if( TelemetryFormat_t::kJson == mFormat )
+    {                   // Identifier contains only letters, digits and underscores (see settings),
+                        // so it needs no escaping
+      mFile << FormatStr( "{\"setup\":{\"identifier\":\"%s\",\"seed\":%llu,\"workers\":%u,\"mode\":\"%s\"}}",
+        identifier, seed, nWorkers, mode ) << std::endl;
+      return;
+    } // if
+
+    mFile << "generation;wallTime;runs;cacheHits;ticks;ticksPerSecond;hits;cancelled;errors;bestMiss;avgMiss;spread";
+    for( uint32_t workerIdx = 0; workerIdx < nWorkers; ++workerIdx )
+      mFile << FormatStr( ";busy_%02u;idle_%02u", workerIdx + 1, workerIdx + 1 );
+    mFile << std::endl;
+
+  } // CSimFireTelemetry::WriteSetup
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireTelemetry::WriteRecord( const Record_t & record )
+  {
+    bool json = TelemetryFormat_t::kJson == mFormat;
+
+    double_t ticksPerSecond = ( 0.0 < record.wallTime ) ? (double_t)record.ticks / record.wallTime : 0.0;
+
+    auto optional = [json]( double_t value ) -> std::string
+    {                   // Values which are not defined (no completed run, fewer than two survivors) are
+                        // passed as the largest number and written as null (empty in CSV)
+      if( std::isfinite( value ) && value < std::numeric_limits<double_t>::max() )
+        return FormatStr( "%.9g", value );
+      return json ? "null" : "";
+    };
+
+    if( json )
+      mLine = FormatStr( "{\"generation\":%zu,\"wallTime\":%.9g,\"runs\":%zu,\"cacheHits\":%zu,\"ticks\":%llu,"
+        "\"ticksPerSecond\":%.9g,\"hits\":%zu,\"cancelled\":%zu,\"errors\":%zu,\"bestMiss\":%s,\"avgMiss\":%s,"
+        "\"spread\":%s,\"workers\":[", record.generation, record.wallTime, record.runs, record.cacheHits,
+        record.ticks, ticksPerSecond, record.hits, record.cancelled, record.errors, optional( record.bestMiss ),
+        optional( record.avgMiss ), optional( record.spread ) );
+    else
+      mLine = FormatStr( "%zu;%.9g;%zu;%zu;%llu;%.9g;%zu;%zu;%zu;%s;%s;%s",
+        record.generation, record.wallTime, record.runs, record.cacheHits, record.ticks, ticksPerSecond,
+        record.hits, record.cancelled, record.errors, optional( record.bestMiss ), optional( record.avgMiss ),
+        optional( record.spread ) );
+
+    for( uint32_t workerIdx = 0; workerIdx < mNWorkers; ++workerIdx )
+    {
+      double_t idle = ( workerIdx < record.workerIdle.size() ) ? record.workerIdle[workerIdx] : 0.0;
+      double_t busy = std::max( 0.0, record.wallTime - idle );
+      if( json )
+        mLine += FormatStr( "%s{\"busy\":%.9g,\"idle\":%.9g}", 0 == workerIdx ? "" : ",", busy, idle );
+      else
+        mLine += FormatStr( ";%.9g;%.9g", busy, idle );
+    } // for
+
+    if( json )
+      mLine += "]}";
+
+    mFile << mLine << std::endl;
+                        // Flushed at once, so the file can be followed while the simulation runs
+
+  } // CSimFireTelemetry::WriteRecord
+
+  //-------------------------------------------------------------------------------------------------
+
+  const std::string & CSimFireTelemetry::GetStrValue( TelemetryFormat_t format )
+  {
+    static const std::string lCsv( "csv" );
+    static const std::string lJson( "json" );
+    static const std::string lInvalidCode( "InvalidCode" );
+
+    switch( format )
+    {
+      case TelemetryFormat_t::kCsv:  return lCsv;
+      case TelemetryFormat_t::kJson: return lJson;
+      default:                       return lInvalidCode;
+    } // switch
+
+  } // CSimFireTelemetry::GetStrValue
+
+} // namespace SimFire
@@ -0,0 +1,115 @@
+//****************************************************************************************************
+//! \file CSimFireTelemetry.h
+//! Module contains declaration of CSimFireTelemetry class, which exports machine-readable statistics
+//! of each generation of the genetic algorithm (throughput, load of workers, quality of the solution)
+//! into CSV or JSON Lines file.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_CSimFireTelemetry
+#define H_CSimFireTelemetry
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <SimFireGlobals.h>
+
+namespace SimFire
+{
+
+  /*! \brief Exports statistics of generations of the genetic algorithm, one record per generation
+      (in steady-state mode per population size of finished runs), so that throughput of the solver
+      can be tracked and compared between versions. Records are written and flushed as soon as they
+      are complete, so the file can be followed during a long simulation. */
+  class CSimFireTelemetry
+  {
+
+  public:
+
+    //! Statistics of one generation
+    struct Record_t {
+      size_t generation;//!< Number of the generation (from 0)
+      double_t wallTime;//!< Time from the start of simulation of the generation to the end of its last run [s]
+      size_t runs;      //!< Number of evaluated runs (simulated or taken from the cache)
+      size_t cacheHits; //!< Number of runs taken from the evaluation cache
+      uint64_t ticks;   //!< Number of ticks (integration steps) of simulated runs
+      size_t hits;      //!< Number of runs which hit the target
+      size_t cancelled; //!< Number of runs which were cancelled or not started
+      size_t errors;    //!< Number of runs which failed (error of the integrator)
+      double_t bestMiss;//!< The least miss distance of completed runs of the generation [m]
+      double_t avgMiss; //!< Average miss distance of completed runs of the generation [m]
+      double_t spread;  //!< Relative spread of elevations of survivors (see CSimFireCore::SurvivorsSpread),
+                        //!< in steady-state mode of the retained population, not of runs of the record
+      std::vector<double_t> workerIdle;
+                        //!< Time each worker waited for the end of the generation (or for a task) [s]
+    };
+
+    //------------------------------------------------------------------------------------------------
+    //! @name Constructors, destructor, clonning, assign operators
+    //@{----------------------------------------------------------------------------------------------
+
+    CSimFireTelemetry( const std::string & filename, TelemetryFormat_t format );
+    /*!< \brief Creates (truncates) the telemetry file.
+
+         \param[in] filename Name of the telemetry file
+         \param[in] format   Format of the file */
+
+    CSimFireTelemetry( const CSimFireTelemetry & ) = delete;
+
+    CSimFireTelemetry & operator=( const CSimFireTelemetry & ) = delete;
+
+    virtual ~CSimFireTelemetry();
+
+    //@}-----------------------------------------------------------------------------------------------
+    //! @name Public methods  */
+    //@{-----------------------------------------------------------------------------------------------
+
+    bool IsOpen() const { return mFile.is_open(); }
+    //!< \brief Returns true if the file was successfully created
+
+    void WriteSetup( const std::string & identifier, uint64_t seed, uint32_t nWorkers, const std::string & mode );
+    /*!< \brief Writes description of the simulation. In JSON format it is the first object of the file,
+         CSV file keeps only records of generations (and the number of workers determines its columns).
+
+         \param[in] identifier Identifier of the simulation
+         \param[in] seed       Seed of the random number generator
+         \param[in] nWorkers   Number of workers (columns of per-worker times)
+         \param[in] mode       Mode of the genetic algorithm (schedule or steady state) */
+
+    void WriteRecord( const Record_t & record );
+    /*!< \brief Writes statistics of one generation and flushes the file.
+
+         \param[in] record Statistics of the generation */
+
+    static const std::string & GetStrValue( TelemetryFormat_t format );
+    /*!< \brief Returns string representation of given telemetry format (as used in settings).
+
+         \param[in] format Telemetry format
+         \return String representation of the format */
+
+    //@}---------------------------------------------------------------------------------------------
+    //! @name Protected data
+    //@{----------------------------------------------------------------------------------------------
+
+  protected:
+
+    std::ofstream mFile;//!< Telemetry file
+
+    TelemetryFormat_t mFormat;
+                        //!< Format of the file
+
+    uint32_t mNWorkers; //!< Number of workers, i.e. number of per-worker columns of CSV file
+
+    std::string mLine;  //!< Line being composed (keeps its capacity between records)
+
+    //@}
+
+  }; // CSimFireTelemetry
+
+} // namespace SimFire
+
+#endif
@@ -0,0 +1,146 @@
+//****************************************************************************************************
+//! \file CSimFireTracer.cpp
+//! Module contains definitions of CSimFireTracer class, declared in CSimFireTracer.h, which records
+//! timeline of simulation in Chrome trace event format.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <algorithm>
+#include <fstream>
+
+#include <CSimFireTracer.h>
+#include <SimFireStringTools.h>
+
+namespace SimFire
+{
+
+  constexpr size_t kInitialSpans = 4096;
+                        // Spans reserved in a new buffer, so that recording does not allocate often
+
+  constexpr uint32_t kTracePid = 1;
+                        // All tracks belong to one process in the trace
+
+  static std::atomic<uint64_t> sNextTracerId( 1 );
+                        // Tracers get unique identifiers, so that a buffer cached by a thread is never
+                        // mistaken for a buffer of another tracer created at the same address
+
+  static std::string TraceTime( int64_t nanoseconds )
+  {                     // Trace event times are in microseconds, written with nanosecond precision
+    return FormatStr( "%lld.%03lld", nanoseconds / 1000, nanoseconds % 1000 );
+  } // TraceTime
+
+  //****** CSimFireTracer ****************************************************************************
+
+  CSimFireTracer::CSimFireTracer():
+    mOrigin( std::chrono::steady_clock::now() ),
+    mTracerId( sNextTracerId.fetch_add( 1, std::memory_order_relaxed ) ),
+    mBuffersMutex(),
+    mBuffers(),
+    mTrackNames()
+  {
+  } // CSimFireTracer::CSimFireTracer
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireTracer::~CSimFireTracer()
+  {
+  } // CSimFireTracer::~CSimFireTracer
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireTracer::AddSpan(
+    uint32_t track,
+    const char * name,
+    const char * category,
+    int64_t start,
+    int64_t end,
+    std::string args )
+  {
+    GetBuffer().push_back( Span_t{ name, category, track, start, std::max<int64_t>( 0, end - start ), std::move( args ) } );
+  } // CSimFireTracer::AddSpan
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireTracer::SetTrackName( uint32_t track, const std::string & name )
+  {
+    std::lock_guard lock( mBuffersMutex );
+    mTrackNames.emplace_back( track, name );
+  } // CSimFireTracer::SetTrackName
+
+  //-------------------------------------------------------------------------------------------------
+
+  size_t CSimFireTracer::GetSpanCount() const
+  {
+    std::lock_guard lock( mBuffersMutex );
+    size_t count = 0;
+    for( const auto & buffer : mBuffers )
+      count += buffer->size();
+    return count;
+  } // CSimFireTracer::GetSpanCount
+
+  //-------------------------------------------------------------------------------------------------
+
+  bool CSimFireTracer::WriteFile( const std::string & filename ) const
+  {
+    std::ofstream file( filename, std::ios::out | std::ios::trunc );
+    if( !file.is_open() )
+      return false;
+
+    std::lock_guard lock( mBuffersMutex );
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+
+    bool first = true;
+    for( const auto & [track, name] : mTrackNames )
+    {                   // Names of tracks are metadata events
+      file << ( first ? "" : ",\n" ) << FormatStr( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,"
+        "\"args\":{\"name\":\"%s\"}}", kTracePid, track, name );
+      first = false;
+    } // for
+
+    for( const auto & buffer : mBuffers )
+      for( const auto & span : *buffer )
+      {                 // Spans are complete events (phase X), viewers sort them by time themselves
+        file << ( first ? "" : ",\n" ) << FormatStr( "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%u,"
+          "\"tid\":%u,\"ts\":%s,\"dur\":%s", span.name, span.category, kTracePid, span.track,
+          TraceTime( span.start ), TraceTime( span.duration ) );
+        if( !span.args.empty() )
+          file << ",\"args\":{" << span.args << "}";
+        file << "}";
+        first = false;
+      } // for
+
+    file << "\n]}" << std::endl;
+
+    return file.good();
+
+  } // CSimFireTracer::WriteFile
+
+  //-------------------------------------------------------------------------------------------------
+
+  std::vector<CSimFireTracer::Span_t> & CSimFireTracer::GetBuffer()
+  {
+    thread_local uint64_t tTracerId = 0;
+    thread_local std::vector<Span_t> * tBuffer = nullptr;
+                        // Buffer of the thread in the tracer it recorded to last. Only this one is kept,
+                        // so the cache does not grow with tracers created during life of the thread (a
+                        // thread returning to an older tracer just gets another buffer in it).
+
+    if( tTracerId == mTracerId )
+      return *tBuffer;
+
+    auto buffer = std::make_unique<std::vector<Span_t>>();
+    buffer->reserve( kInitialSpans );
+
+    std::lock_guard lock( mBuffersMutex );
+    tTracerId = mTracerId;
+    tBuffer = buffer.get();
+    mBuffers.push_back( std::move( buffer ) );
+    return *tBuffer;
+
+  } // CSimFireTracer::GetBuffer
+
+} // namespace SimFire
@@ -0,0 +1,140 @@
+//****************************************************************************************************
+//! \file CSimFireTracer.h
+//! Module contains declaration of CSimFireTracer class, which records timeline of simulation (runs,
+//! bunches of runs of workers, breeding, waiting at barriers) and writes it as Chrome trace event JSON,
+//! which can be viewed in Perfetto or chrome://tracing.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_CSimFireTracer
+#define H_CSimFireTracer
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SimFireGlobals.h>
+
+namespace SimFire
+{
+
+  //***** CSimFireTracer *****************************************************************************
+
+  /*!  \brief Records spans (named intervals of time on a track of a thread) and writes them to a file in
+       Chrome trace event format. Each thread recording spans gets its own buffer on its first span, from
+       then on recording takes no lock (only the thread itself appends to its buffer), so tracing does not
+       serialize simulation workers. Buffers are written to the file only by WriteFile, when no thread
+       records spans.
+
+       Track of a span is given explicitly, so that a thread may record spans of another track (e.g. the
+       main thread records waiting of workers at the barrier, which it measures). */
+  class CSimFireTracer
+  {
+
+  public:
+
+    //------------------------------------------------------------------------------------------------
+    //! @name Constructors, destructor, clonning, assign operators
+    //@{----------------------------------------------------------------------------------------------
+
+    CSimFireTracer();
+    /*!< \brief Creates empty tracer, times of spans are measured from its creation. */
+
+    CSimFireTracer( const CSimFireTracer & ) = delete;
+
+    CSimFireTracer & operator=( const CSimFireTracer & ) = delete;
+
+    virtual ~CSimFireTracer();
+
+    //@}-----------------------------------------------------------------------------------------------
+    //! @name Public methods  */
+    //@{-----------------------------------------------------------------------------------------------
+
+    int64_t Now() const
+    //!< \brief Returns time since creation of the tracer [ns]
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - mOrigin ).count();
+    } // Now
+
+    int64_t ToTracerTime( std::chrono::steady_clock::time_point time ) const
+    //!< \brief Returns given time as time since creation of the tracer [ns]
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>( time - mOrigin ).count();
+    } // ToTracerTime
+
+    void AddSpan( uint32_t track, const char * name, const char * category, int64_t start, int64_t end,
+      std::string args = std::string() );
+    /*!< \brief Records a span to the buffer of the calling thread (thread safe, lock-free except for the
+         first span of the thread).
+
+         \param[in] track    Track (thread identifier in the trace) the span belongs to
+         \param[in] name     Name of the span (string literal, it is not copied)
+         \param[in] category Category of the span (string literal, it is not copied)
+         \param[in] start    Start of the span (see Now) [ns]
+         \param[in] end      End of the span (see Now) [ns]
+         \param[in] args     Members of JSON object with arguments of the span (e.g. "\"runs\":4"), or empty */
+
+    void SetTrackName( uint32_t track, const std::string & name );
+    /*!< \brief Names a track (shown instead of its number by trace viewers).
+
+         \param[in] track Track
+         \param[in] name  Name of the track */
+
+    size_t GetSpanCount() const;
+    //!< \brief Returns number of spans recorded so far (no thread should record spans)
+
+    bool WriteFile( const std::string & filename ) const;
+    /*!< \brief Writes all recorded spans as Chrome trace event JSON (no thread should record spans).
+
+         \param[in] filename Name of the file
+         \return true if the file was written */
+
+    //@}---------------------------------------------------------------------------------------------
+    //! @name Protected data
+    //@{----------------------------------------------------------------------------------------------
+
+  protected:
+
+    //! One recorded span
+    struct Span_t {
+      const char * name;//!< Name of the span
+      const char * category;
+                        //!< Category of the span
+      uint32_t track;   //!< Track the span belongs to
+      int64_t start;    //!< Start of the span [ns]
+      int64_t duration; //!< Duration of the span [ns]
+      std::string args; //!< Members of JSON object with arguments (may be empty)
+    };
+
+    std::vector<Span_t> & GetBuffer();
+    /*!< \brief Returns buffer of the calling thread, the buffer is created on the first call.
+
+         \return Buffer of the calling thread */
+
+    std::chrono::steady_clock::time_point mOrigin;
+                        //!< Time of creation of the tracer, times of spans are relative to it
+
+    uint64_t mTracerId; //!< Unique identifier of the tracer, keys buffers cached by threads
+
+    mutable std::mutex mBuffersMutex;
+                        //!< Guards the lists of buffers and names of tracks
+
+    std::vector<std::unique_ptr<std::vector<Span_t>>> mBuffers;
+                        //!< Buffers of all threads which recorded a span
+
+    std::vector<std::pair<uint32_t, std::string>> mTrackNames;
+                        //!< Names of tracks
+
+    //@}
+
+  }; // CSimFireTracer
+
+} // namespace SimFire
+
+#endif
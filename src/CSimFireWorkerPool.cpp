@@ -0,0 +1,301 @@
+//****************************************************************************************************
+//! \file CSimFireWorkerPool.cpp
+//! Module contains definitions of CSimFireWorkerPool class, declared in CSimFireWorkerPool.h, which
+//! is a pool of long-lived worker threads processing tasks from a common queue.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include <CSimFireWorkerPool.h>
+
+namespace SimFire
+{
+
+  //****** CSimFireWorkerPool ************************************************************************
+
+  CSimFireWorkerPool::CSimFireWorkerPool( uint32_t nWorkers ):
+    mThreads(),
+    mMutex(),
+    mTaskAvailable(),
+    mAllDone(),
+    mQueue(),
+    mBusyWorkers( 0 ),
+    mStop( false ),
+    mFirstException(),
+    mTasksDone( 0 ),
+    mQueueWait( Clock_t::duration::zero() ),
+    mMaxQueueWait( Clock_t::duration::zero() ),
+    mIdle( std::max( 1u, nWorkers ), Clock_t::duration::zero() )
+  {
+    mThreads.reserve( mIdle.size() );
+    for( uint32_t workerIdx = 0; workerIdx < mIdle.size(); ++workerIdx )
+      mThreads.emplace_back( &CSimFireWorkerPool::WorkerLoop, this, workerIdx );
+  } // CSimFireWorkerPool::CSimFireWorkerPool
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireWorkerPool::~CSimFireWorkerPool()
+  {
+    {
+      std::lock_guard lock( mMutex );
+      mStop = true;
+    }
+    mTaskAvailable.notify_all();
+
+    for( auto & thread : mThreads )
+      thread.join();
+
+  } // CSimFireWorkerPool::~CSimFireWorkerPool
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireWorkerPool::Submit( Task_t task )
+  {
+    {
+      std::lock_guard lock( mMutex );
+      mQueue.push_back( QueueItem_t{ std::move( task ), Clock_t::now() } );
+    }
+    mTaskAvailable.notify_one();
+
+  } // CSimFireWorkerPool::Submit
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireWorkerPool::Wait()
+  {
+    std::unique_lock lock( mMutex );
+    mAllDone.wait( lock, [this] { return mQueue.empty() && 0 == mBusyWorkers; } );
+
+    if( mFirstException )
+      std::rethrow_exception( std::exchange( mFirstException, nullptr ) );
+
+  } // CSimFireWorkerPool::Wait
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireWorkerPool::JobStats_t CSimFireWorkerPool::ForEachRange(
+    size_t count,
+    ScheduleType_t schedule,
+    size_t chunk,
+    const RangeTask_t & fn )
+  {
+    uint32_t nWorkers = GetNumberOfWorkers();
+
+    if( ScheduleType_t::kDynamic != schedule )
+    {                   // The first (count % nWorkers) slices are one item longer
+      std::vector<size_t> partEnds;
+      for( uint32_t part = 0; part < nWorkers; ++part )
+        partEnds.push_back( ( partEnds.empty() ? 0 : partEnds.back() ) + count / nWorkers +
+          ( ( part < count % nWorkers ) ? 1 : 0 ) );
+      return ForEachPart( partEnds, fn );
+    } // if
+
+    auto jobStart = Clock_t::now();
+    std::vector<Clock_t::time_point> finished( nWorkers, jobStart );
+                        // End of the last part processed by each worker, written only by the worker itself
+
+    std::atomic<size_t> nextItem( 0 );
+    chunk = std::max<size_t>( 1, chunk );
+
+    for( uint32_t part = 0; part < nWorkers; ++part )
+      Submit( [&]( uint32_t workerIdx )
+      {
+        for( size_t first = nextItem.fetch_add( chunk ); first < count; first = nextItem.fetch_add( chunk ) )
+          fn( first, std::min( first + chunk, count ), workerIdx );
+        finished[workerIdx] = Clock_t::now();
+      } );
+
+    return FinishJob( jobStart, finished );
+
+  } // CSimFireWorkerPool::ForEachRange
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireWorkerPool::JobStats_t CSimFireWorkerPool::ForEachPart(
+    const std::vector<size_t> & partEnds,
+    const RangeTask_t & fn )
+  {
+    auto jobStart = Clock_t::now();
+    std::vector<Clock_t::time_point> finished( GetNumberOfWorkers(), jobStart );
+                        // End of the last part processed by each worker, written only by the worker itself
+
+    size_t first = 0;
+    for( size_t last : partEnds )
+    {
+      if( first < last )
+        Submit( [&, first, last]( uint32_t workerIdx )
+        {
+          fn( first, last, workerIdx );
+          finished[workerIdx] = Clock_t::now();
+        } );
+      first = last;
+    } // for
+
+    return FinishJob( jobStart, finished );
+
+  } // CSimFireWorkerPool::ForEachPart
+
+  //-------------------------------------------------------------------------------------------------
+
+  CSimFireWorkerPool::JobStats_t CSimFireWorkerPool::FinishJob(
+    Clock_t::time_point jobStart,
+    const std::vector<Clock_t::time_point> & finished )
+  {
+    Wait();
+
+    auto jobEnd = *std::max_element( finished.begin(), finished.end() );
+
+    JobStats_t stats{ std::chrono::duration<double_t>( jobEnd - jobStart ).count(), 0.0, {}, jobEnd };
+    stats.workerIdle.reserve( finished.size() );
+    for( auto & workerEnd : finished )
+    {
+      stats.workerIdle.push_back( std::chrono::duration<double_t>( jobEnd - workerEnd ).count() );
+      stats.barrierIdle += stats.workerIdle.back();
+    } // for
+
+    return stats;
+
+  } // CSimFireWorkerPool::FinishJob
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireWorkerPool::PartitionLongestFirst(
+    const std::vector<double_t> & costs,
+    uint32_t nParts,
+    std::vector<size_t> & order,
+    std::vector<size_t> & partEnds )
+  {
+    nParts = std::max( 1u, nParts );
+
+    std::vector<size_t> byCost( costs.size() );
+    std::iota( byCost.begin(), byCost.end(), 0 );
+    std::stable_sort( byCost.begin(), byCost.end(), [&costs]( size_t a, size_t b ) { return costs[a] > costs[b]; } );
+
+    std::vector<std::vector<size_t>> parts( nParts );
+    std::vector<double_t> load( nParts, 0.0 );
+    for( size_t item : byCost )
+    {                   // Part with the least load so far (the first one of equal loads)
+      auto part = std::distance( load.begin(), std::min_element( load.begin(), load.end() ) );
+      parts[part].push_back( item );
+      load[part] += costs[item];
+    } // for
+
+    order.clear();
+    partEnds.clear();
+    for( auto & part : parts )
+    {
+      order.insert( order.end(), part.begin(), part.end() );
+      partEnds.push_back( order.size() );
+    } // for
+
+  } // CSimFireWorkerPool::PartitionLongestFirst
+
+  //-------------------------------------------------------------------------------------------------
+
+  const std::string & CSimFireWorkerPool::GetStrValue( ScheduleType_t schedule )
+  {
+    static const std::string lStatic( "static" );
+    static const std::string lDynamic( "dynamic" );
+    static const std::string lLongestFirst( "lpt" );
+    static const std::string lInvalidCode( "InvalidCode" );
+
+    switch( schedule )
+    {
+      case ScheduleType_t::kStatic:       return lStatic;
+      case ScheduleType_t::kDynamic:      return lDynamic;
+      case ScheduleType_t::kLongestFirst: return lLongestFirst;
+      default:                            return lInvalidCode;
+    } // switch
+
+  } // CSimFireWorkerPool::GetStrValue
+
+  //-------------------------------------------------------------------------------------------------
+
+  uint64_t CSimFireWorkerPool::GetTasksDone() const
+  {
+    std::lock_guard lock( mMutex );
+    return mTasksDone;
+  } // CSimFireWorkerPool::GetTasksDone
+
+  //-------------------------------------------------------------------------------------------------
+
+  double_t CSimFireWorkerPool::GetQueueWaitTime() const
+  {
+    std::lock_guard lock( mMutex );
+    return std::chrono::duration<double_t>( mQueueWait ).count();
+  } // CSimFireWorkerPool::GetQueueWaitTime
+
+  //-------------------------------------------------------------------------------------------------
+
+  double_t CSimFireWorkerPool::GetMaxQueueWaitTime() const
+  {
+    std::lock_guard lock( mMutex );
+    return std::chrono::duration<double_t>( mMaxQueueWait ).count();
+  } // CSimFireWorkerPool::GetMaxQueueWaitTime
+
+  //-------------------------------------------------------------------------------------------------
+
+  double_t CSimFireWorkerPool::GetIdleTime( uint32_t workerIdx ) const
+  {
+    std::lock_guard lock( mMutex );
+    return ( workerIdx < mIdle.size() ) ? std::chrono::duration<double_t>( mIdle[workerIdx] ).count() : 0.0;
+  } // CSimFireWorkerPool::GetIdleTime
+
+  //-------------------------------------------------------------------------------------------------
+
+  void CSimFireWorkerPool::WorkerLoop( uint32_t workerIdx )
+  {
+    std::unique_lock lock( mMutex );
+
+    while( true )
+    {
+      auto idleStart = Clock_t::now();
+      mTaskAvailable.wait( lock, [this] { return mStop || !mQueue.empty(); } );
+
+      auto taskStart = Clock_t::now();
+      mIdle[workerIdx] += taskStart - idleStart;
+
+      if( mQueue.empty() )
+        return;         // Stop requested and nothing left to do
+
+      QueueItem_t item = std::move( mQueue.front() );
+      mQueue.pop_front();
+
+      auto queueWait = taskStart - item.submitted;
+      mQueueWait += queueWait;
+      mMaxQueueWait = std::max( mMaxQueueWait, queueWait );
+      ++mBusyWorkers;
+
+      lock.unlock();
+
+      std::exception_ptr exception;
+      try
+      {
+        item.task( workerIdx );
+      }
+      catch( ... )
+      {                 // Reported to the caller by Wait, the worker itself continues
+        exception = std::current_exception();
+      }
+
+      lock.lock();
+
+      if( exception && !mFirstException )
+        mFirstException = exception;
+
+      ++mTasksDone;
+      --mBusyWorkers;
+      if( mQueue.empty() && 0 == mBusyWorkers )
+        mAllDone.notify_all();
+
+    } // while
+
+  } // CSimFireWorkerPool::WorkerLoop
+
+} // namespace SimFire
@@ -0,0 +1,213 @@
+//****************************************************************************************************
+//! \file CSimFireWorkerPool.h
+//! Module contains declaration of CSimFireWorkerPool class, a pool of long-lived worker threads
+//! processing tasks from a common queue.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_CSimFireWorkerPool
+#define H_CSimFireWorkerPool
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <SimFireGlobals.h>
+
+namespace SimFire
+{
+
+  //***** CSimFireWorkerPool *************************************************************************
+
+  /*!  \brief Pool of worker threads which are created once and then process tasks from a common FIFO
+       queue until the pool is destroyed. Each task gets index of the worker executing it, so callers
+       may keep per-worker objects (run workers with warm registries and buffers) indexed by it.
+
+       The pool measures how long tasks wait in the queue before a worker picks them up and how long
+       workers wait for tasks (idle time). */
+  class CSimFireWorkerPool
+  {
+
+  public:
+
+    using Task_t = std::function<void( uint32_t workerIdx )>;
+                        //!< Task to be processed, receives index of the worker (0 .. number of workers - 1)
+
+    using RangeTask_t = std::function<void( size_t first, size_t last, uint32_t workerIdx )>;
+                        //!< Part of an indexed job, processes items from first to last (excluded)
+
+    //! Statistics of one indexed job
+    struct JobStats_t {
+      double_t wallTime;//!< Time from the start of the job to the end of its last part [s]
+      double_t barrierIdle;
+                        //!< Sum of times workers waited for the end of the job after their last part [s]
+      std::vector<double_t> workerIdle;
+                        //!< Time each worker waited for the end of the job after its last part [s]
+      std::chrono::steady_clock::time_point end;
+                        //!< End of the last part of the job
+    };
+
+    //------------------------------------------------------------------------------------------------
+    //! @name Constructors, destructor, clonning, assign operators
+    //@{----------------------------------------------------------------------------------------------
+
+    CSimFireWorkerPool( uint32_t nWorkers );
+    /*!< \brief Creates the pool and starts its worker threads.
+
+         \param[in] nWorkers Number of worker threads (at least one is created) */
+
+    CSimFireWorkerPool( const CSimFireWorkerPool & ) = delete;
+
+    CSimFireWorkerPool & operator=( const CSimFireWorkerPool & ) = delete;
+
+    virtual ~CSimFireWorkerPool();
+    /*!< \brief Lets workers finish all queued tasks and joins their threads. */
+
+    //@}-----------------------------------------------------------------------------------------------
+    //! @name Public methods  */
+    //@{-----------------------------------------------------------------------------------------------
+
+    void Submit( Task_t task );
+    /*!< \brief Puts the task at the end of the queue, one of idle workers is woken up.
+
+         \param[in] task Task to be processed */
+
+    void Wait();
+    /*!< \brief Blocks until the queue is empty and no worker is processing a task. If any task ended
+         by exception since the last call, the first such exception is rethrown. */
+
+    JobStats_t ForEachRange( size_t count, ScheduleType_t schedule, size_t chunk, const RangeTask_t & fn );
+    /*!< \brief Processes items 0 .. count - 1 by all workers and waits for the end. With static schedule
+         each worker gets one contiguous slice of equal size, with dynamic schedule workers repeatedly
+         take next chunk of items from a shared atomic counter, so a worker which ends early simply
+         takes more items. Longest first schedule needs costs of items (see PartitionLongestFirst and
+         ForEachPart), it is treated as static here. Must not be called concurrently with other jobs
+         of the pool.
+
+         \param[in] count    Number of items
+         \param[in] schedule Distribution of items among workers
+         \param[in] chunk    Number of items taken at once (dynamic schedule only)
+         \param[in] fn       Function processing a range of items
+         \return Wall time of the job and idle time of workers at its final barrier */
+
+    JobStats_t ForEachPart( const std::vector<size_t> & partEnds, const RangeTask_t & fn );
+    /*!< \brief Processes items split into given parts, each part is one task (taken by the first free
+         worker) and waits for the end. Part i contains items from partEnds[i - 1] (0 for the first
+         part) to partEnds[i] (excluded). Must not be called concurrently with other jobs of the pool.
+
+         \param[in] partEnds End of each part (ascending)
+         \param[in] fn       Function processing a range of items
+         \return Wall time of the job and idle time of workers at its final barrier */
+
+    static void PartitionLongestFirst(
+      const std::vector<double_t> & costs,
+      uint32_t nParts,
+      std::vector<size_t> & order,
+      std::vector<size_t> & partEnds );
+    /*!< \brief Splits items with given costs into parts with balanced total cost by longest processing
+         time first rule: items are taken from the most costly one and each is put to the part with
+         the least total cost so far. The result is deterministic (ties are resolved by index).
+
+         \param[in]  costs    Predicted cost of each item
+         \param[in]  nParts   Number of parts (workers)
+         \param[out] order    Indices of items ordered by parts (items of part 0 first)
+         \param[out] partEnds End of each part in order (see ForEachPart) */
+
+    static const std::string & GetStrValue( ScheduleType_t schedule );
+    /*!< \brief Returns string representation of given schedule.
+
+         \param[in] schedule Schedule
+         \return String representation of the schedule */
+
+    uint32_t GetNumberOfWorkers() const { return (uint32_t)mThreads.size(); }
+    //!< \brief Returns number of worker threads
+
+    uint64_t GetTasksDone() const;
+    //!< \brief Returns number of tasks processed so far
+
+    double_t GetQueueWaitTime() const;
+    //!< \brief Returns total time the processed tasks spent waiting in the queue [s]
+
+    double_t GetMaxQueueWaitTime() const;
+    //!< \brief Returns the longest time a single task spent waiting in the queue [s]
+
+    double_t GetIdleTime( uint32_t workerIdx ) const;
+    //!< \brief Returns time the worker spent waiting for tasks so far (waiting in progress excluded) [s]
+
+    //@}---------------------------------------------------------------------------------------------
+    //! @name Protected data
+    //@{----------------------------------------------------------------------------------------------
+
+  protected:
+
+    using Clock_t = std::chrono::steady_clock;
+                        //!< Clock used for all metrics
+
+    //! Task waiting in the queue
+    struct QueueItem_t {
+      Task_t task;      //!< Task to be processed
+      Clock_t::time_point submitted;
+                        //!< Time the task was put into the queue
+    };
+
+    JobStats_t FinishJob( Clock_t::time_point jobStart, const std::vector<Clock_t::time_point> & finished );
+    /*!< \brief Waits for the end of a job and evaluates its statistics.
+
+         \param[in] jobStart Start of the job
+         \param[in] finished End of the last part processed by each worker
+         \return Wall time of the job and idle time of workers at its final barrier */
+
+    void WorkerLoop( uint32_t workerIdx );
+    /*!< \brief Body of the worker thread, takes tasks from the queue until the pool is stopped.
+
+         \param[in] workerIdx Index of the worker */
+
+    std::vector<std::thread> mThreads;
+                        //!< Worker threads
+
+    mutable std::mutex mMutex;
+                        //!< Guards the queue, state and metrics below
+
+    std::condition_variable mTaskAvailable;
+                        //!< Signals a new task in the queue (or stop request) to workers
+
+    std::condition_variable mAllDone;
+                        //!< Signals empty queue and no task in progress to waiting callers
+
+    std::deque<QueueItem_t> mQueue;
+                        //!< Tasks waiting for a worker
+
+    uint32_t mBusyWorkers;
+                        //!< Number of workers processing a task right now
+
+    bool mStop;         //!< If true, workers end as soon as the queue is empty
+
+    std::exception_ptr mFirstException;
+                        //!< First exception thrown by a task since the last Wait
+
+    uint64_t mTasksDone;//!< Number of processed tasks
+
+    Clock_t::duration mQueueWait;
+                        //!< Total time processed tasks spent in the queue
+
+    Clock_t::duration mMaxQueueWait;
+                        //!< Longest time a single task spent in the queue
+
+    std::vector<Clock_t::duration> mIdle;
+                        //!< Time each worker spent waiting for tasks
+
+    //@}
+
+  }; // CSimFireWorkerPool
+
+} // namespace SimFire
+
+#endif
@@ -17,6 +17,7 @@
 #include <CSimFireSettings.h>
 #include <CSimFireCore.h>
 #include <CSimFireCSVExporter.h>
+#include <CSimFireBenchmark.h>
 
 //******* Command line help **************************************************************************
 
@@ -34,6 +35,7 @@ void PrintCommandlineHelp()
 
   HlpLine() << "--help"              << "Print this help" << std::endl;
   HlpLine() << "--setup <File name>" << "Path to INI file containing setup" << std::endl;
+  HlpLine() << "--benchmark"         << "Compare integrators on test shots of the setup instead of simulation" << std::endl;
 
   std::cout << std::endl << std::endl;
   std::cout << "INI file expected values: " << std::endl << std::endl;
@@ -116,17 +118,26 @@ int main( int argc, char * argv[] )
 
   bool res = true;
 
-  if( settings.GetDoTestRun() )
+  if( cfg.GetValueBool( {}, "benchmark" ) )
+  {
+    std::cout << asteriskLine << std::endl;
+    std::cout << "Integrators benchmark: " << std::endl;
+    std::cout << asteriskLine << std::endl << std::endl;
+
+    SimFire::CSimFireBenchmark benchmark( settings );
+    res = benchmark.Run( std::cout );
+  } // if
+  else if( settings.GetDoTestRun() )
   {
     SimFire::CSimFireSingleRun runWorker( settings,
-      [](const std::string& id, const std::string& mssg)
+      [](SimFire::LogLevel_t, const std::string& id, const std::string& mssg)
       {
          std::cout << "[" << id << "]   " << mssg << std::endl;
       } );
 
     SimFire::CSimFireSingleRunParams runPars;
-    runPars.mRunIdentifier = "TRUN";
-    runPars.mThreadIdentifier = "Main";
+    runPars.mRunLabel = SimFire::CSimFireSingleRunParams::RunLabel_t::kTestRun;
+    runPars.mThreadLabel = SimFire::CSimFireSingleRunParams::ThreadLabel_t::kMain;
 
     SimFire::CSimFireCSVExporter csvExporter( settings );
     auto& csvTemplate = settings.GetCSVExportTemplate();
@@ -160,14 +171,15 @@ int main( int argc, char * argv[] )
       {
         // Template example:  simTest_%s_%04u_%.3f.csv
         auto csvFileName = SimFire::FormatStr(csvTemplate.c_str(),
-          settings.GetSimIdentifier() + "_" + runPars.mRunIdentifier,
+          settings.GetSimIdentifier() + "_" + runPars.GetRunIdentifier(),
           (unsigned)settings.GetVelocity(), runPars.mVelocityZCoef);
         csvExporter.NewFile(csvFileName);
       } // if
 
       runWorker.Run( runPars );
       std::cout << "Test " << runPars.GetRunDesc() << " ended with code "
-        << SimFire::CSimFireSingleRunParams::GetStrValue(runPars.mReturnCode) << std::endl;
+        << SimFire::CSimFireSingleRunParams::GetStrValue(runPars.mReturnCode)
+        << " (" << runPars.GetStepsDesc() << ")" << std::endl;
       if (runPars.mReturnCode == SimFire::CSimFireSingleRunParams::SimResCode_t::kError)
         res = false;
       else if (runPars.mReturnCode == SimFire::CSimFireSingleRunParams::SimResCode_t::kEndedCollision)
@@ -187,13 +199,14 @@ int main( int argc, char * argv[] )
 		uint32_t hitNr = 0;
     for( auto & hit : allHits )
     {
-      std::cout << hit.GetRunDesc() << std::endl;
+      std::cout << hit.GetRunDesc() << SimFire::FormatStr( " impact t = %.4f s at [%.3f, %.3f, %.3f]",
+        hit.mImpactTime, hit.mContactX, hit.mContactY, hit.mContactZ ) << std::endl;
 
       if( settings.ExportRunsToCSV() && settings.GetCSVHitsOnly() )
       {
         // Template example:  simTest_%s_%04u_%.3f.csv
         auto csvFileName = SimFire::FormatStr( csvTemplate.c_str(),
-          settings.GetSimIdentifier() + "_" + hit.mRunIdentifier,
+          settings.GetSimIdentifier() + "_" + hit.GetRunIdentifier(),
           ++hitNr, hit.mVelocityZCoef );
         csvExporter.NewFile( csvFileName );
 
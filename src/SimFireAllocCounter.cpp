@@ -0,0 +1,69 @@
+//****************************************************************************************************
+//! \file SimFireAllocCounter.cpp
+//! Module contains definitions of functions declared in SimFireAllocCounter.h and, if enabled by
+//! SIMFIRE_COUNT_ALLOCATIONS, replacement of global operators new and delete.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <cstdlib>
+#include <new>
+
+#include <SimFireAllocCounter.h>
+
+#if defined( SIMFIRE_COUNT_ALLOCATIONS )
+
+namespace
+{
+  thread_local uint64_t tlAllocationCount = 0;
+  //!< Allocations made by the thread, each thread of the simulation counts its own
+}
+
+void * operator new( std::size_t size )
+{
+  ++tlAllocationCount;
+  if( void * ptr = std::malloc( size ? size : 1 ) )
+    return ptr;
+  throw std::bad_alloc();
+} // operator new
+
+void * operator new[]( std::size_t size )
+{
+  return operator new( size );
+} // operator new[]
+
+void * operator new( std::size_t size, const std::nothrow_t & ) noexcept
+{
+  ++tlAllocationCount;
+  return std::malloc( size ? size : 1 );
+} // operator new
+
+void * operator new[]( std::size_t size, const std::nothrow_t & ) noexcept
+{
+  return operator new( size, std::nothrow );
+} // operator new[]
+
+void operator delete( void * ptr ) noexcept                     { std::free( ptr ); }
+void operator delete[]( void * ptr ) noexcept                   { std::free( ptr ); }
+void operator delete( void * ptr, std::size_t ) noexcept        { std::free( ptr ); }
+void operator delete[]( void * ptr, std::size_t ) noexcept      { std::free( ptr ); }
+
+#endif
+
+namespace SimFire
+{
+
+  //-------------------------------------------------------------------------------------------------
+
+  uint64_t GetAllocationCount()
+  {
+#if defined( SIMFIRE_COUNT_ALLOCATIONS )
+    return tlAllocationCount;
+#else
+    return 0;
+#endif
+  } // GetAllocationCount
+
+} // namespace SimFire
@@ -0,0 +1,34 @@
+//****************************************************************************************************
+//! \file SimFireAllocCounter.h
+//! Module contains optional counting of heap allocations, which is used to verify that hot loops of
+//! the simulation do not allocate memory in steady state.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_SimFireAllocCounter
+#define H_SimFireAllocCounter
+
+#include <SimFireGlobals.h>
+
+namespace SimFire
+{
+
+#if defined( SIMFIRE_COUNT_ALLOCATIONS )
+  constexpr bool gAllocationCounting = true;
+#else
+  constexpr bool gAllocationCounting = false;
+#endif
+  //!< True if global operators new and delete are replaced by counting ones (compile with
+  //!  SIMFIRE_COUNT_ALLOCATIONS defined)
+
+  uint64_t GetAllocationCount();
+  /*!< \brief Returns number of heap allocations made by the calling thread so far.
+
+       \return Number of allocations (always 0 if counting is not compiled in) */
+
+} // namespace SimFire
+
+#endif
@@ -49,6 +49,65 @@ namespace SimFire
     kComplexNumeric     = 6,
   };
 
+  //! Instruction set used by vectorized code
+  enum class SimdLevel_t: unsigned short
+  {
+    kAuto               = 0,    //!< Best instruction set supported by the CPU
+    kScalar             = 1,    //!< Plain scalar code
+    kSSE2               = 2,    //!< SSE2 (two doubles per instruction)
+    kAVX2               = 3,    //!< AVX2 (four doubles per instruction)
+  };
+
+  //! Distribution of runs of one generation among worker threads
+  enum class ScheduleType_t: unsigned short
+  {
+    kStatic             = 0,    //!< Equal contiguous slice of runs for each thread
+    kDynamic            = 1,    //!< Threads take runs one after another from a shared counter
+    kLongestFirst       = 2,    //!< Runs with the longest predicted flight are assigned first, each
+                                //!  to the thread with the least predicted work
+  };
+
+  //! What asynchronous logger does with a message when the buffer of the thread is full
+  enum class LogOverflow_t: unsigned short
+  {
+    kBlock              = 0,    //!< The thread waits until the writer makes room (no message is lost)
+    kDrop               = 1,    //!< The message is dropped and counted (the thread never waits)
+  };
+
+  //! Severity of a log message, messages below the level given in settings are not formatted at all
+  enum class LogLevel_t: unsigned short
+  {
+    kTrace              = 0,    //!< Ticks and ends of individual runs
+    kDebug              = 1,    //!< Listings and statistics of each generation
+    kInfo               = 2,    //!< Results of the simulation
+    kWarning            = 3,    //!< Runs which could not be simulated
+    kError              = 4,    //!< Simulation which could not be performed
+    kOff                = 5,    //!< Nothing is logged (settings only)
+  };
+
+  //! Format of the file with telemetry of generations
+  enum class TelemetryFormat_t: unsigned short
+  {
+    kCsv                = 0,    //!< One line of values separated by semicolons per generation
+    kJson               = 1,    //!< One JSON object per line (JSON Lines), the first one describes the setup
+  };
+
+#if defined( SIMFIRE_LOG_FLOOR )
+  constexpr LogLevel_t gLogFloor = static_cast<LogLevel_t>( SIMFIRE_LOG_FLOOR );
+#elif defined( NDEBUG )
+  constexpr LogLevel_t gLogFloor = LogLevel_t::kDebug;
+#else
+  constexpr LogLevel_t gLogFloor = LogLevel_t::kTrace;
+#endif
+  //!< Lowest level of messages compiled in, calls of lower levels are removed from the code (release
+  //!  builds remove trace messages unless compiled with SIMFIRE_LOG_FLOOR set to 0)
+
+  constexpr uint64_t gCancelCheckTicks = 64;
+  //!< Number of ticks between two checks of the cancellation token by running simulations
+
+  constexpr size_t gCacheLineSize = 64;
+  //!< Size of cache line, records written by different threads are aligned to it (no false sharing)
+
   constexpr double_t gAlmostZero = 1E-12;
   //!< Specifies the size of a number that is already considered zero
 
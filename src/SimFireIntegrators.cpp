@@ -0,0 +1,185 @@
+//****************************************************************************************************
+//! \file SimFireIntegrators.cpp
+//! Module contains definitions of functions declared in SimFireIntegrators.h (numerical integrators
+//! of bullet equations of motion).
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <SimFireIntegrators.h>
+
+namespace SimFire
+{
+
+  //-------------------------------------------------------------------------------------------------
+
+  const std::string & GetStrValue( IntegratorType_t type )
+  {
+    static const std::string lEuler( "euler" );
+    static const std::string lDormandPrince( "dopri5" );
+    static const std::string lSymplecticEuler( "symplectic" );
+    static const std::string lVelocityVerlet( "verlet" );
+    static const std::string lRungeKutta4( "rk4" );
+    static const std::string lAnalytic( "analytic" );
+    static const std::string lInvalid( "invalid" );
+
+    switch( type )
+    {
+      case IntegratorType_t::kEuler:            return lEuler;
+      case IntegratorType_t::kDormandPrince:    return lDormandPrince;
+      case IntegratorType_t::kSymplecticEuler:  return lSymplecticEuler;
+      case IntegratorType_t::kVelocityVerlet:   return lVelocityVerlet;
+      case IntegratorType_t::kRungeKutta4:      return lRungeKutta4;
+      case IntegratorType_t::kAnalytic:         return lAnalytic;
+      default:                                  return lInvalid;
+    } // switch
+  } // GetStrValue
+
+  //-------------------------------------------------------------------------------------------------
+
+  void VacuumState( const OdeState_t & y0, double_t g, double_t t, OdeState_t & y )
+  {
+    y[0] = y0[0] + y0[3] * t;
+    y[1] = y0[1] + y0[4] * t;
+    y[2] = y0[2] + y0[5] * t - 0.5 * g * t * t;
+    y[3] = y0[3];
+    y[4] = y0[4];
+    y[5] = y0[5] - g * t;
+  } // VacuumState
+
+  //-------------------------------------------------------------------------------------------------
+
+  double_t VacuumGroundTime( const OdeState_t & y0, double_t g )
+  {
+    if( y0[2] < 0.0 )
+      return 0.0;       // Body below the ground is out of the scene immediately
+    return ( y0[5] + std::sqrt( y0[5] * y0[5] + 2.0 * g * y0[2] ) ) / g;
+  } // VacuumGroundTime
+
+  //-------------------------------------------------------------------------------------------------
+
+  VacuumEncounter_t VacuumEncounter(
+    const OdeState_t & y0,
+    double_t g,
+    const Point_t & centre,
+    double_t radius,
+    double_t tEnd )
+  {
+    double_t dX = y0[0] - centre[0];
+    double_t dY = y0[1] - centre[1];
+    double_t dZ = y0[2] - centre[2];
+
+    auto distSq = [&]( double_t t ) -> double_t
+    {
+      double_t x = dX + y0[3] * t;
+      double_t y = dY + y0[4] * t;
+      double_t z = dZ + y0[5] * t - 0.5 * g * t * t;
+      return x * x + y * y + z * z;
+    };
+
+    double_t c0 = dX * y0[3] + dY * y0[4] + dZ * y0[5];
+    double_t c1 = y0[3] * y0[3] + y0[4] * y0[4] + y0[5] * y0[5] - g * dZ;
+    double_t c2 = -1.5 * g * y0[5];
+    double_t c3 = 0.5 * g * g;
+    auto rate = [&]( double_t t ) -> double_t { return c0 + t * ( c1 + t * ( c2 + t * c3 ) ); };
+                        // Half of the derivative of the squared distance, relative position times
+                        // relative velocity
+
+    std::array<double_t, 4> split{ 0.0, tEnd, tEnd, tEnd };
+    size_t nrSplit = 1;
+    double_t disc = c2 * c2 - 3.0 * c1 * c3;
+    if( 0.0 < disc )
+    {                   // Roots of the derivative of the rate divide the interval into parts where
+                        // the rate is monotonous, so each part contains one root at most
+      double_t sq = std::sqrt( disc );
+      for( double_t t : { ( -c2 - sq ) / ( 3.0 * c3 ), ( -c2 + sq ) / ( 3.0 * c3 ) } )
+        if( 0.0 < t && t < tEnd )
+          split[nrSplit++] = t;
+    } // if
+    split[nrSplit++] = tEnd;
+
+    std::array<double_t, 5> extremes;
+    size_t nrExtremes = 0;
+    extremes[nrExtremes++] = 0.0;
+    for( size_t i = 0; i + 1 < nrSplit; ++i )
+    {
+      double_t lo = split[i];
+      double_t hi = split[i + 1];
+      double_t rLo = rate( lo );
+      double_t rHi = rate( hi );
+      if( rLo < 0.0 && rHi >= 0.0 )
+        extremes[nrExtremes++] = FindRoot( rate, lo, hi );
+      else if( rLo > 0.0 && rHi <= 0.0 )
+        extremes[nrExtremes++] = FindRoot( [&]( double_t t ) { return -rate( t ); }, lo, hi );
+    } // for
+    extremes[nrExtremes++] = tEnd;
+                        // Squared distance is monotonous between neighbouring extremes
+
+    VacuumEncounter_t result{ 0.0, distSq( 0.0 ), false, 0.0 };
+    double_t radiusSq = radius * radius;
+
+    if( result.minDistSq < radiusSq )
+    {
+      result.contact = true;
+      result.contactTime = 0.0;
+      return result;
+    } // if
+
+    for( size_t i = 1; i < nrExtremes; ++i )
+    {
+      double_t dSq = distSq( extremes[i] );
+      if( dSq < radiusSq )
+      {                 // First contact lies on the approaching part before this extreme, the body
+                        // does not continue through the target.
+        result.contact = true;
+        result.contactTime = FindRoot( [&]( double_t t ) { return radiusSq - distSq( t ); },
+          extremes[i - 1], extremes[i] );
+        result.minTime = result.contactTime;
+        result.minDistSq = distSq( result.contactTime );
+        return result;
+      } // if
+
+      if( dSq < result.minDistSq )
+      {
+        result.minDistSq = dSq;
+        result.minTime = extremes[i];
+      } // if
+    } // for
+
+    return result;
+
+  } // VacuumEncounter
+
+  //-------------------------------------------------------------------------------------------------
+
+  uint32_t VacuumElevations(
+    const Point_t & from,
+    const Point_t & to,
+    double_t speed,
+    double_t g,
+    std::array<double_t, 2> & tanElevation )
+  {
+    double_t dX = to[0] - from[0];
+    double_t dY = to[1] - from[1];
+    double_t height = to[2] - from[2];
+    double_t range = std::sqrt( dX * dX + dY * dY );
+
+    if( IsZero( range ) )
+      return 0;         // Elevation is not defined for the target straight above or below
+
+    double_t speedSq = speed * speed;
+    double_t disc = speedSq * speedSq - g * ( g * range * range + 2.0 * height * speedSq );
+    if( disc < 0.0 )
+      return 0;         // Target is out of reach of given muzzle velocity
+
+    double_t sq = std::sqrt( disc );
+    tanElevation[0] = ( speedSq - sq ) / ( g * range );
+    tanElevation[1] = ( speedSq + sq ) / ( g * range );
+
+    return IsZero( sq ) ? 1 : 2;
+
+  } // VacuumElevations
+
+} // namespace SimFire
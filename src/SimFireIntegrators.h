@@ -0,0 +1,338 @@
+//****************************************************************************************************
+//! \file SimFireIntegrators.h
+//! Module contains numerical integrators of bullet equations of motion, which are used as an
+//! alternative to the basic time discretization (fixed-step Euler) of CSimFireSingleRun.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_SimFireIntegrators
+#define H_SimFireIntegrators
+
+#include <array>
+
+#include <SimFireGlobals.h>
+
+namespace SimFire
+{
+
+  //! Integration method of bullet equations of motion
+  enum class IntegratorType_t: unsigned short
+  {
+    kEuler              = 0,    //!< Fixed step, processors procURM, procADRG, procDVA (reference)
+    kDormandPrince      = 1,    //!< Adaptive step, embedded Runge-Kutta 5(4) with dense output
+    kSymplecticEuler    = 2,    //!< Fixed step, velocity is updated first and moves the body (1st order)
+    kVelocityVerlet     = 3,    //!< Fixed step, velocity Verlet (2nd order)
+    kRungeKutta4        = 4,    //!< Fixed step, classical Runge-Kutta (4th order)
+    kAnalytic           = 5,    //!< No time stepping, closed-form solution of motion in vacuum
+  };
+
+  const std::string & GetStrValue( IntegratorType_t type );
+  /*!< \brief Returns string representation (INI file value) of given integration method.
+
+       \param[in] type Integration method
+       \return String representation of the method */
+
+  using OdeState_t = std::array<double_t, 6>;
+  //!< State of a body: position X, Y, Z [m] and velocity vX, vY, vZ [m/s]
+
+  //***** BallisticDerivative_t **********************************************************************
+
+  /*! \brief Right-hand side of equations of motion of a sphere in homogeneous gravitational field
+      with aerodynamic drag, dy/dt = f(y). Drag acceleration is 1/2 * rho * Cd * A / m * |v| * v
+      against the velocity vector (see procADRG). */
+  struct BallisticDerivative_t
+  {
+    double_t g;         //!< Gravitational acceleration [m/s^2]
+    double_t dragK;     //!< 1/2 * air density * Cd * cross section / mass [1/m] (0 in vacuum)
+
+    void operator()( const OdeState_t & y, OdeState_t & dy ) const
+    {
+      double_t v = std::sqrt( y[3] * y[3] + y[4] * y[4] + y[5] * y[5] );
+      double_t dragA = dragK * v;
+
+      dy[0] = y[3];
+      dy[1] = y[4];
+      dy[2] = y[5];
+      dy[3] = -dragA * y[3];
+      dy[4] = -dragA * y[4];
+      dy[5] = -dragA * y[5] - g;
+    } // BallisticDerivative_t::operator()
+
+  }; // BallisticDerivative_t
+
+  //***** DormandPrinceDense_t ***********************************************************************
+
+  /*! \brief Dense output of one accepted Dormand-Prince step. Allows to evaluate the state anywhere
+      inside the step with 4th order accuracy (continuous extension by Hairer, Norsett and Wanner). */
+  struct DormandPrinceDense_t
+  {
+    std::array<OdeState_t, 5> rcont;
+                        //!< Coefficients of the interpolation polynomial
+    double_t t0;        //!< Time at the beginning of the step [s]
+    double_t h;         //!< Length of the step [s]
+
+    void Evaluate( double_t theta, OdeState_t & y ) const
+    {                   // theta = (t - t0) / h, from interval <0, 1>
+      double_t theta1 = 1.0 - theta;
+      for( size_t i = 0; i < y.size(); ++i )
+        y[i] = rcont[0][i] + theta * ( rcont[1][i] + theta1 * ( rcont[2][i] +
+               theta * ( rcont[3][i] + theta1 * rcont[4][i] ) ) );
+    } // DormandPrinceDense_t::Evaluate
+
+  }; // DormandPrinceDense_t
+
+  //***** DormandPrinceStep **************************************************************************
+
+  template<typename Derivative_t>
+  double_t DormandPrinceStep(
+    const Derivative_t & f,
+    const OdeState_t & y0,
+    const OdeState_t & k1,
+    double_t h,
+    double_t atol,
+    double_t rtol,
+    OdeState_t & y1,
+    OdeState_t & k7,
+    DormandPrinceDense_t * dense = nullptr )
+  /*!< \brief Performs one trial step of Dormand-Prince 5(4) method.
+
+       \param[in]  f     Right-hand side of the equations, f( y, dy )
+       \param[in]  y0    State at the beginning of the step
+       \param[in]  k1    Derivative at the beginning of the step (FSAL, k7 of the previous step)
+       \param[in]  h     Length of the step [s]
+       \param[in]  atol  Absolute tolerance
+       \param[in]  rtol  Relative tolerance
+       \param[out] y1    State at the end of the step (5th order solution)
+       \param[out] k7    Derivative at the end of the step
+       \param[out] dense Dense output of the step (filled only if not null)
+       \return Scaled error norm, the step is acceptable if it is not greater than 1 */
+  {
+    OdeState_t k2, k3, k4, k5, k6, yt;
+
+    for( size_t i = 0; i < yt.size(); ++i )
+      yt[i] = y0[i] + h * ( 1.0 / 5.0 ) * k1[i];
+    f( yt, k2 );
+    for( size_t i = 0; i < yt.size(); ++i )
+      yt[i] = y0[i] + h * ( 3.0 / 40.0 * k1[i] + 9.0 / 40.0 * k2[i] );
+    f( yt, k3 );
+    for( size_t i = 0; i < yt.size(); ++i )
+      yt[i] = y0[i] + h * ( 44.0 / 45.0 * k1[i] - 56.0 / 15.0 * k2[i] + 32.0 / 9.0 * k3[i] );
+    f( yt, k4 );
+    for( size_t i = 0; i < yt.size(); ++i )
+      yt[i] = y0[i] + h * ( 19372.0 / 6561.0 * k1[i] - 25360.0 / 2187.0 * k2[i] +
+                            64448.0 / 6561.0 * k3[i] - 212.0 / 729.0 * k4[i] );
+    f( yt, k5 );
+    for( size_t i = 0; i < yt.size(); ++i )
+      yt[i] = y0[i] + h * ( 9017.0 / 3168.0 * k1[i] - 355.0 / 33.0 * k2[i] + 46732.0 / 5247.0 * k3[i] +
+                            49.0 / 176.0 * k4[i] - 5103.0 / 18656.0 * k5[i] );
+    f( yt, k6 );
+    for( size_t i = 0; i < y1.size(); ++i )
+      y1[i] = y0[i] + h * ( 35.0 / 384.0 * k1[i] + 500.0 / 1113.0 * k3[i] + 125.0 / 192.0 * k4[i] -
+                            2187.0 / 6784.0 * k5[i] + 11.0 / 84.0 * k6[i] );
+    f( y1, k7 );
+
+    double_t errSum = 0.0;
+    for( size_t i = 0; i < y1.size(); ++i )
+    {                   // Difference between 5th and embedded 4th order solutions
+      double_t err = h * ( 71.0 / 57600.0 * k1[i] - 71.0 / 16695.0 * k3[i] + 71.0 / 1920.0 * k4[i] -
+                           17253.0 / 339200.0 * k5[i] + 22.0 / 525.0 * k6[i] - 1.0 / 40.0 * k7[i] );
+      double_t scale = atol + rtol * std::max( std::fabs( y0[i] ), std::fabs( y1[i] ) );
+      errSum += ( err / scale ) * ( err / scale );
+    } // for
+
+    if( nullptr != dense )
+    {
+      dense->h = h;
+      for( size_t i = 0; i < y1.size(); ++i )
+      {
+        double_t ydiff = y1[i] - y0[i];
+        double_t bspl = h * k1[i] - ydiff;
+        dense->rcont[0][i] = y0[i];
+        dense->rcont[1][i] = ydiff;
+        dense->rcont[2][i] = bspl;
+        dense->rcont[3][i] = ydiff - h * k7[i] - bspl;
+        dense->rcont[4][i] = h * ( -12715105075.0 / 11282082432.0 * k1[i] + 87487479700.0 / 32700410799.0 * k3[i] -
+                                   10690763975.0 / 1880347072.0 * k4[i] + 701980252875.0 / 199316789632.0 * k5[i] -
+                                   1453857185.0 / 822651844.0 * k6[i] + 69997945.0 / 29380423.0 * k7[i] );
+      } // for
+    } // if
+
+    return std::sqrt( errSum / (double_t)y1.size() );
+
+  } // DormandPrinceStep
+
+  //***** FixedStep *********************************************************************************
+
+  template<IntegratorType_t kScheme, typename Derivative_t>
+  inline void FixedStep( const Derivative_t & f, OdeState_t & y, double_t h )
+  /*!< \brief Performs one step of given fixed-step scheme. Scheme is a template parameter, so that
+       each scheme is compiled into its own loop without any branching inside.
+
+       \param[in]     f Right-hand side of the equations, f( y, dy )
+       \param[in,out] y State of the body, replaced by the state at the end of the step
+       \param[in]     h Length of the step [s] */
+  {
+    OdeState_t k1;
+    f( y, k1 );
+
+    if constexpr( IntegratorType_t::kSymplecticEuler == kScheme )
+    {                   // Kick, then drift with the new velocity
+      for( size_t i = 3; i < 6; ++i )
+        y[i] += h * k1[i];
+      for( size_t i = 0; i < 3; ++i )
+        y[i] += h * y[i + 3];
+    } // if
+    else if constexpr( IntegratorType_t::kVelocityVerlet == kScheme )
+    {                   // Acceleration depends on velocity (drag), so it is evaluated at the end of
+                        // the step with predicted velocity
+      OdeState_t yt, k2;
+      for( size_t i = 0; i < 3; ++i )
+      {
+        yt[i] = y[i] + h * y[i + 3] + 0.5 * h * h * k1[i + 3];
+        yt[i + 3] = y[i + 3] + h * k1[i + 3];
+      } // for
+      f( yt, k2 );
+      for( size_t i = 0; i < 3; ++i )
+      {
+        y[i] = yt[i];
+        y[i + 3] += 0.5 * h * ( k1[i + 3] + k2[i + 3] );
+      } // for
+    } // else if
+    else if constexpr( IntegratorType_t::kRungeKutta4 == kScheme )
+    {
+      OdeState_t k2, k3, k4, yt;
+      for( size_t i = 0; i < yt.size(); ++i )
+        yt[i] = y[i] + 0.5 * h * k1[i];
+      f( yt, k2 );
+      for( size_t i = 0; i < yt.size(); ++i )
+        yt[i] = y[i] + 0.5 * h * k2[i];
+      f( yt, k3 );
+      for( size_t i = 0; i < yt.size(); ++i )
+        yt[i] = y[i] + h * k3[i];
+      f( yt, k4 );
+      for( size_t i = 0; i < y.size(); ++i )
+        y[i] += h / 6.0 * ( k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i] );
+    } // else if
+    else
+    {                   // Explicit Euler, same as the processors procURM, procADRG and procDVA
+      for( size_t i = 0; i < y.size(); ++i )
+        y[i] += h * k1[i];
+    } // else
+
+  } // FixedStep
+
+  //***** FindRoot **********************************************************************************
+
+  template<typename Function_t>
+  double_t FindRoot( const Function_t & fn, double_t lo, double_t hi )
+  /*!< \brief Finds root of given function on interval <lo, hi> by bisection. The function must
+       have different signs at the ends of the interval, fn( lo ) < 0 and fn( hi ) >= 0 is assumed
+       (the result is the first point where the function is not negative).
+
+       \param[in] fn Function of one variable, double_t fn( double_t )
+       \param[in] lo Lower end of the interval
+       \param[in] hi Upper end of the interval
+       \return Upper estimate of the root (fn is not negative there) */
+  {
+    for( int i = 0; i < 60 && gAlmostZero < hi - lo; ++i )
+    {
+      double_t mid = 0.5 * ( lo + hi );
+      if( fn( mid ) < 0.0 )
+        lo = mid;
+      else
+        hi = mid;
+    } // for
+    return hi;
+  } // FindRoot
+
+  //***** ProvablyReceding **************************************************************************
+
+  inline bool ProvablyReceding( double_t distX, double_t distY, double_t vX, double_t vY, double_t boundSq )
+  /*!< \brief Returns true if a body can never again get closer to the target than given bound. Gravity
+       is vertical and drag acts against the velocity, so the horizontal velocity never changes its
+       direction (only its size). Horizontal distance from the target measured along that direction
+       therefore never decreases and it is a lower bound of all future distances.
+
+       \param[in] distX   X distance of the body from the target [m]
+       \param[in] distY   Y distance of the body from the target [m]
+       \param[in] vX      X component of the body velocity [m/s]
+       \param[in] vY      Y component of the body velocity [m/s]
+       \param[in] boundSq Squared distance the body must not get under [m^2]
+       \return true if the body is receding from the target for good */
+  {
+    double_t projection = distX * vX + distY * vY;
+                        // Horizontal distance along the horizontal velocity, times its size
+    return ( 0.0 < projection && boundSq * ( vX * vX + vY * vY ) <= projection * projection );
+  } // ProvablyReceding
+
+  //***** Closed-form solution in vacuum ************************************************************
+
+  using Point_t = std::array<double_t, 3>;
+  //!< Point in the scene: X, Y, Z [m]
+
+  //! Encounter of a body flying in vacuum with a stationary sphere
+  struct VacuumEncounter_t
+  {
+    double_t minTime;   //!< Time of the minimal distance of the body to the sphere centre [s]
+    double_t minDistSq; //!< Squared minimal distance of the body to the sphere centre [m^2]
+    bool contact;       //!< True if the body touches the sphere
+    double_t contactTime;
+                        //!< Time of the first contact [s] (valid only if contact is true)
+  };
+
+  void VacuumState( const OdeState_t & y0, double_t g, double_t t, OdeState_t & y );
+  /*!< \brief Evaluates state of a body in homogeneous gravitational field without drag.
+
+       \param[in]  y0 State at time 0
+       \param[in]  g  Gravitational acceleration [m/s^2]
+       \param[in]  t  Time [s]
+       \param[out] y  State at time t */
+
+  double_t VacuumGroundTime( const OdeState_t & y0, double_t g );
+  /*!< \brief Returns time when a body flying in vacuum falls to the ground plane z = 0 (0 if it starts
+       on the ground and does not rise, or below the ground).
+
+       \param[in] y0 State at time 0
+       \param[in] g  Gravitational acceleration [m/s^2]
+       \return Time of the ground crossing [s] */
+
+  VacuumEncounter_t VacuumEncounter(
+    const OdeState_t & y0,
+    double_t g,
+    const Point_t & centre,
+    double_t radius,
+    double_t tEnd );
+  /*!< \brief Finds the closest approach of a body flying in vacuum to given point and the first contact
+       with the sphere around it on time interval <0, tEnd>. Extremes of the squared distance (roots of
+       a cubic polynomial) are separated by roots of its derivative and refined by bisection, so no
+       time stepping is involved.
+
+       \param[in] y0     State at time 0
+       \param[in] g      Gravitational acceleration [m/s^2]
+       \param[in] centre Centre of the sphere
+       \param[in] radius Radius of the sphere (sum of radii of the body and the target) [m]
+       \param[in] tEnd   End of the time interval [s]
+       \return Closest approach and the first contact */
+
+  uint32_t VacuumElevations(
+    const Point_t & from,
+    const Point_t & to,
+    double_t speed,
+    double_t g,
+    std::array<double_t, 2> & tanElevation );
+  /*!< \brief Solves elevation of the shot hitting given point in vacuum. There are two solutions
+       (low and high arc) if the point is within the reach, one on the boundary of the reach.
+
+       \param[in]  from         Position of the shooter
+       \param[in]  to           Position of the target
+       \param[in]  speed        Muzzle velocity [m/s]
+       \param[in]  g            Gravitational acceleration [m/s^2]
+       \param[out] tanElevation Tangents of elevation angles, low arc first
+       \return Number of solutions (0 if the point is out of reach or straight above the shooter) */
+
+} // namespace SimFire
+
+#endif
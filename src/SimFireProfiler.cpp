@@ -0,0 +1,101 @@
+//****************************************************************************************************
+//! \file SimFireProfiler.cpp
+//! Module contains definitions of functions declared in SimFireProfiler.h.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#include <memory>
+#include <mutex>
+
+#include <SimFireProfiler.h>
+
+namespace
+{
+  std::mutex gProfilesMutex;
+  //!< Guards the list of counters of threads (taken once per thread and when collecting)
+
+  std::vector<std::unique_ptr<SimFire::ProcProfile_t>> gProfiles;
+  //!< Counters of all threads which profiled anything
+
+  thread_local SimFire::ProcProfile_t * tlProfile = nullptr;
+  //!< Counters of the calling thread (in gProfiles)
+}
+
+namespace SimFire
+{
+
+  //-------------------------------------------------------------------------------------------------
+
+  ProcProfile_t & GetThreadProcProfile()
+  {
+    if( nullptr == tlProfile )
+    {
+      std::lock_guard lock( gProfilesMutex );
+      gProfiles.push_back( std::make_unique<ProcProfile_t>() );
+      gProfiles.back()->fill( ProcCounters_t{ 0, 0, 0 } );
+      tlProfile = gProfiles.back().get();
+    } // if
+
+    return *tlProfile;
+
+  } // GetThreadProcProfile
+
+  //-------------------------------------------------------------------------------------------------
+
+  std::vector<ProcProfile_t> CollectProcProfiles()
+  {
+    std::lock_guard lock( gProfilesMutex );
+    std::vector<ProcProfile_t> profiles;
+    for( const auto & profile : gProfiles )
+      profiles.push_back( *profile );
+    return profiles;
+  } // CollectProcProfiles
+
+  //-------------------------------------------------------------------------------------------------
+
+  void ResetProcProfiles()
+  {
+    std::lock_guard lock( gProfilesMutex );
+    for( auto & profile : gProfiles )
+      profile->fill( ProcCounters_t{ 0, 0, 0 } );
+  } // ResetProcProfiles
+
+  //-------------------------------------------------------------------------------------------------
+
+  const std::string & GetStrValue( ProfiledProc_t proc )
+  {
+    static const std::string lURM( "URM" );
+    static const std::string lADRG( "ADRG" );
+    static const std::string lDVA( "DVA" );
+    static const std::string lOCS( "OCS" );
+    static const std::string lActCheck( "ActCheck" );
+    static const std::string lOCC( "OCC" );
+    static const std::string lPPS( "PPS" );
+    static const std::string lFSI( "FSI" );
+    static const std::string lCAT( "CAT" );
+    static const std::string lFused( "Fused" );
+    static const std::string lDOPRI( "DOPRI" );
+    static const std::string lInvalidCode( "InvalidCode" );
+
+    switch( proc )
+    {
+      case ProfiledProc_t::kURM:      return lURM;
+      case ProfiledProc_t::kADRG:     return lADRG;
+      case ProfiledProc_t::kDVA:      return lDVA;
+      case ProfiledProc_t::kOCS:      return lOCS;
+      case ProfiledProc_t::kActCheck: return lActCheck;
+      case ProfiledProc_t::kOCC:      return lOCC;
+      case ProfiledProc_t::kPPS:      return lPPS;
+      case ProfiledProc_t::kFSI:      return lFSI;
+      case ProfiledProc_t::kCAT:      return lCAT;
+      case ProfiledProc_t::kFused:    return lFused;
+      case ProfiledProc_t::kDOPRI:    return lDOPRI;
+      default:                        return lInvalidCode;
+    } // switch
+
+  } // GetStrValue
+
+} // namespace SimFire
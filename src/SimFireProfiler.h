@@ -0,0 +1,144 @@
+//****************************************************************************************************
+//! \file SimFireProfiler.h
+//! Module contains optional profiling of processors of single runs (number of ticks, wall time and
+//! CPU cycles spent in each processor), accumulated per thread.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_SimFireProfiler
+#define H_SimFireProfiler
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include <SimFireGlobals.h>
+
+#if defined( SIMFIRE_PROFILE_PROCESSORS ) && ( defined( _M_X64 ) || defined( __x86_64__ ) )
+  #define SIMFIRE_PROFILE_CYCLES
+  #if defined( _MSC_VER )
+    #include <intrin.h>
+  #else
+    #include <x86intrin.h>
+  #endif
+#endif
+                        // Cycles are counted by rdtsc on x64 only, elsewhere they stay zero
+
+namespace SimFire
+{
+
+#if defined( SIMFIRE_PROFILE_PROCESSORS )
+  constexpr bool gProcessorProfiling = true;
+#else
+  constexpr bool gProcessorProfiling = false;
+#endif
+  //!< True if processors of single runs are profiled (compile with SIMFIRE_PROFILE_PROCESSORS defined),
+  //!  otherwise the profiling code is not compiled at all
+
+  //! Profiled processors of a single run
+  enum class ProfiledProc_t: unsigned short
+  {
+    kURM                = 0,    //!< Uniform rectilinear motion
+    kADRG               = 1,    //!< Aerodynamic drag
+    kDVA                = 2,    //!< Gravitational acceleration
+    kOCS                = 3,    //!< Out of scene check
+    kActCheck           = 4,    //!< Activity check
+    kOCC                = 5,    //!< Object collision check
+    kPPS                = 6,    //!< Previous position store (swept spheres)
+    kFSI                = 7,    //!< Fixed step integrator of higher order
+    kCAT                = 8,    //!< Closest approach tracking
+    kFused              = 9,    //!< Fused single-pass kernel (including its closest approach tracking)
+    kDOPRI              = 10,   //!< Adaptive Dormand-Prince integrator (including its tracking)
+    kCount              = 11    //!< Number of profiled processors
+  };
+
+  //! Counters of one processor
+  struct ProcCounters_t {
+    uint64_t ticks;     //!< Number of calls (ticks)
+    uint64_t nanoseconds;
+                        //!< Wall time spent in the processor [ns]
+    uint64_t cycles;    //!< CPU cycles spent in the processor (time stamp counter)
+  };
+
+  using ProcProfile_t = std::array<ProcCounters_t, (size_t)ProfiledProc_t::kCount>;
+  //!< Counters of all processors of one thread
+
+  ProcProfile_t & GetThreadProcProfile();
+  /*!< \brief Returns counters of the calling thread, they are created (zeroed) on the first call.
+
+       \return Counters of the calling thread */
+
+  std::vector<ProcProfile_t> CollectProcProfiles();
+  /*!< \brief Returns copy of counters of all threads which profiled anything, in order of their first
+       profiled call. Profiled threads should be idle.
+
+       \return Counters of each thread */
+
+  void ResetProcProfiles();
+  //!< \brief Zeroes counters of all threads (profiled threads should be idle)
+
+  const std::string & GetStrValue( ProfiledProc_t proc );
+  /*!< \brief Returns name of given processor.
+
+       \param[in] proc Processor
+       \return Name of the processor */
+
+  inline uint64_t ReadCycleCounter()
+  //!< \brief Returns time stamp counter of the CPU (0 if not available or profiling is not compiled in)
+  {
+#if defined( SIMFIRE_PROFILE_CYCLES )
+    return __rdtsc();
+#else
+    return 0;
+#endif
+  } // ReadCycleCounter
+
+  //! Measures one call of a processor, adds it to counters of the thread when destroyed
+  struct ProcTimer_t {
+
+    ProcTimer_t( ProfiledProc_t proc ):
+      mCounters( GetThreadProcProfile()[(size_t)proc] ),
+      mStart( std::chrono::steady_clock::now() ),
+      mStartCycles( ReadCycleCounter() )
+    {}
+
+    ProcTimer_t( const ProcTimer_t & ) = delete;
+
+    ~ProcTimer_t()
+    {
+      mCounters.cycles += ReadCycleCounter() - mStartCycles;
+      mCounters.nanoseconds += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - mStart ).count();
+      ++mCounters.ticks;
+    } // ProcTimer_t::~ProcTimer_t
+
+    ProcCounters_t & mCounters;
+                        //!< Counters of the processor in the calling thread
+    std::chrono::steady_clock::time_point mStart;
+                        //!< Wall time of the start of the call
+    uint64_t mStartCycles;
+                        //!< Time stamp counter at the start of the call
+  };
+
+  //! Replaces ProcTimer_t when profiling is not compiled in
+  struct NoProcTimer_t {};
+
+  inline auto StartProcTimer( ProfiledProc_t proc )
+  /*!< \brief Starts measuring a call of processor, the call is measured until the returned object is
+       destroyed. Returns an empty object (no code at all) if profiling is not compiled in.
+
+       \param[in] proc Processor
+       \return Timer of the call */
+  {
+    if constexpr( gProcessorProfiling )
+      return ProcTimer_t( proc );
+    else
+      return NoProcTimer_t{};
+  } // StartProcTimer
+
+} // namespace SimFire
+
+#endif
@@ -0,0 +1,75 @@
+//****************************************************************************************************
+//! \file SimFireRandom.h
+//! Module contains counter-based random number generator (Philox4x32-10), which gives the same
+//! numbers for the same key and counter regardless of order of calls or thread making them.
+//****************************************************************************************************
+//
+//****************************************************************************************************
+// 16. 10. 2026, V. Pospíšil, gdermog@seznam.cz
+//****************************************************************************************************
+
+#ifndef H_SimFireRandom
+#define H_SimFireRandom
+
+#include <array>
+
+#include <SimFireGlobals.h>
+
+namespace SimFire
+{
+
+  using PhiloxBlock_t = std::array<uint32_t, 4>;
+  //!< Counter or output block of Philox generator
+
+  using PhiloxKey_t = std::array<uint32_t, 2>;
+  //!< Key of Philox generator
+
+  inline PhiloxBlock_t Philox4x32( PhiloxBlock_t counter, PhiloxKey_t key )
+  /*!< \brief Philox4x32-10 bijection (Salmon et al., Parallel random numbers: as easy as 1, 2, 3):
+       ten rounds of multiplication and key mixing which turn the counter into four random words.
+       Each distinct counter gives independent output, so any number can be computed directly.
+
+       \param[in] counter Counter (position in the stream)
+       \param[in] key     Key (selects the stream)
+       \return Four random 32-bit words */
+  {
+    constexpr uint64_t kM0 = 0xD2511F53;
+    constexpr uint64_t kM1 = 0xCD9E8D57;
+    constexpr uint32_t kW0 = 0x9E3779B9;
+    constexpr uint32_t kW1 = 0xBB67AE85;
+
+    for( int round = 0; round < 10; ++round )
+    {
+      uint64_t p0 = kM0 * counter[0];
+      uint64_t p1 = kM1 * counter[2];
+      counter = { (uint32_t)( p1 >> 32 ) ^ counter[1] ^ key[0], (uint32_t)p1,
+                  (uint32_t)( p0 >> 32 ) ^ counter[3] ^ key[1], (uint32_t)p0 };
+      key[0] += kW0;
+      key[1] += kW1;
+    } // for
+
+    return counter;
+
+  } // Philox4x32
+
+  inline double_t RandomUniform( uint64_t seed, uint64_t stream, uint32_t item, uint32_t draw = 0 )
+  /*!< \brief Returns uniformly distributed random number from interval <0, 1), which depends only
+       on given arguments.
+
+       \param[in] seed   Seed given by the user (key of the generator)
+       \param[in] stream Stream of numbers, e.g. number of generation
+       \param[in] item   Item using the number within the stream, e.g. index of chromosome
+       \param[in] draw   Number of the draw for the same item (if more numbers are needed)
+       \return Random number (53 random bits) */
+  {
+    auto block = Philox4x32(
+      { item, draw, (uint32_t)stream, (uint32_t)( stream >> 32 ) },
+      { (uint32_t)seed, (uint32_t)( seed >> 32 ) } );
+
+    return (double_t)( ( ( (uint64_t)block[0] << 32 ) | block[1] ) >> 11 ) * 0x1.0p-53;
+
+  } // RandomUniform
+
+} // namespace SimFire
+
+#endif